@@ -28,14 +28,20 @@ namespace Terathon
 	//# The $Array$ class represents a dynamically resizable array of objects
 	//# for which any entry can be accessed in constant time.
 	//
-	//# \def	template <typename type, int32 baseCount = 0> class Array final : public ImmutableArray<type>
+	//# \def	template <typename type, int32 baseCount = 0, class allocatorType = HeapArrayAllocator, typename countType = int32, class growthType = DefaultArrayGrowth, int32 alignment = 0> class Array final : public ImmutableArray<type, countType>
 	//
 	//# \tparam		type			The type of the class that can be stored in the array.
 	//# \tparam		baseCount		The minimum number of array elements for which storage is available inside the $Array$ object itself.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the array elements when they don't fit inside the $Array$ object.
+	//# \tparam		countType		The signed integer type used to store element counts and indexes. This must be $int32$ or $int64$.
+	//# \tparam		growthType		The policy that determines how much storage is reserved when the array grows.
+	//# \tparam		alignment		The minimum alignment, in bytes, of the storage for the array elements. This must be zero or a power of two.
 	//
 	//# \ctor	explicit Array(int32 count = 0);
+	//# \ctor	Array(int32 count, const allocatorType& allocator);
 	//
-	//# \param	count	The number of array elements for which space is initially reserved in the array's storage.
+	//# \param	count		The number of array elements for which space is initially reserved in the array's storage.
+	//# \param	allocator	An allocator object that is copied into the array and used for all of its storage.
 	//
 	//# \desc
 	//# The $Array$ class represents a homogeneous array of objects whose type is given by the
@@ -53,11 +59,59 @@ namespace Terathon
 	//# structure of the $Array$ object so that no separate allocations need to be made until the size
 	//# of the array exceeds the value of $baseCount$.
 	//#
-	//# The $count$ parameter can only be specified if the $baseCount$ template parameter is zero.
+	//# The $count$ parameter can only be specified if the $baseCount$ template parameter is zero. If the
+	//# $baseCount$ template parameter is greater than zero, then the $allocator$ parameter can be passed to
+	//# the constructor by itself.
 	//#
+	//# Heap storage is obtained from the allocator specified by the $allocatorType$ template parameter. By default,
+	//# this is the $@HeapArrayAllocator@$ class, which uses the $new$ and $delete$ operators. Custom allocators can
+	//# hold state, and they can extend existing blocks in place to avoid moving array elements when an array grows.
+	//#
+	//# If the $@TriviallyRelocatable@$ class template indicates that objects of type $type$ are trivially relocatable,
+	//# then elements are moved as raw memory whenever the storage is reallocated and whenever elements are inserted
+	//# or removed. Otherwise, elements are individually move-constructed in their new locations, and the old objects
+	//# are destroyed.
+	//#
+	//# By default, element counts and indexes are stored as 32-bit integers, limiting an array to 2<sup>31</sup>&#x202F;&minus;&#x202F;1
+	//# elements. If the $countType$ template parameter is $int64$, then all counts and indexes taken and returned by
+	//# the array's member functions have the type $int64$, and the array can hold more elements than that. The $LargeArray$
+	//# alias template defined below is a convenient way to declare such an array. Growth of the storage is always clamped
+	//# so that neither the element count nor the total size in bytes can overflow, and a request for more elements than
+	//# can be stored is treated as an allocation failure.
+	//
+	//# \source
+	//# template <typename type, int32 baseCount = 0, class allocatorType = HeapArrayAllocator, class growthType = DefaultArrayGrowth>\n
+	//# using LargeArray = Array<type, baseCount, allocatorType, int64, growthType>;
+	//
+	//# \desc
+	//# The amount by which the storage grows is determined by the $growthType$ template parameter. The default policy,
+	//# $@DefaultArrayGrowth@$, increases the reserved count by about half each time more space is needed. The policies
+	//# $@GeometricArrayGrowth@$, $@LinearArrayGrowth@$, $@PowerOfTwoArrayGrowth@$, and $@PageArrayGrowth@$ can be specified
+	//# instead, and custom policies can be written with the same interface. Storage is never released when elements are
+	//# removed, but it can be trimmed to the current size by calling the $@Array::ShrinkArray@$ function.
+	//#
+	//# The storage for the array elements is always aligned to the natural alignment of $type$. If the $alignment$
+	//# template parameter is larger than that, then both the storage built into the $Array$ object and any storage
+	//# allocated on the heap are aligned to $alignment$ bytes instead, and the size of the storage is rounded up to a
+	//# multiple of $alignment$ bytes. This lets vectorized code use aligned loads and stores starting at the first
+	//# element, and a full vector can be read from any aligned address inside the array without touching memory outside
+	//# of its storage. Aligning arrays used by different threads to the cache line size also keeps them from sharing cache
+	//# lines. Heap storage with an alignment larger than the one guaranteed by the allocator is obtained by allocating
+	//# a somewhat larger block, and in that case, the array does not use the allocator's $ReallocateArrayStorage$ function.
+	//# The $AlignedArray$ alias template defined below is a convenient way to declare an aligned array.
+	//
+	//# \source
+	//# template <typename type, int32 alignment, int32 baseCount = 0, class allocatorType = HeapArrayAllocator>\n
+	//# using AlignedArray = Array<type, baseCount, allocatorType, int32, DefaultArrayGrowth, alignment>;
+	//
+	//# \desc
 	//# An $Array$ object can be implicitly converted to a pointer to its first element. This allows the
 	//# use of the $[]$ operator to access individual elements of the array.
 	//#
+	//# When an array is assigned to another array, the storage of the destination array is reused if it is large
+	//# enough, so no allocation takes place. When an array is moved into another array, its heap storage is transferred
+	//# without moving any objects. Objects held in the storage built into the $Array$ object are moved individually.
+	//#
 	//# It is possible to iterate over the elements of an array using a range-based for loop.
 	//# This is illustrated by the following code, where $array$ is a variable of type $Array<type>$.
 	//
@@ -67,7 +121,7 @@ namespace Terathon
 	//# \t...\n
 	//# }
 	//
-	//# \privbase	ImmutableArray<type>	Used internally.
+	//# \privbase	ImmutableArray<type, countType>		Used internally.
 	//
 	//# \also	$@List@$
 
@@ -159,6 +213,47 @@ namespace Terathon
 	//# \also	$@Array::SetArrayElementCount@$
 
 
+	//# \function	Array::EmplaceArrayElement		Constructs a new object at the end of an array.
+	//
+	//# \proto	template <typename... T> type *EmplaceArrayElement(T&&... args);
+	//
+	//# \param	args	The arguments that are passed to the constructor of the new element.
+	//
+	//# \desc
+	//# The $EmplaceArrayElement$ function increases the size of an array by one and constructs the new element
+	//# directly in the array's storage by passing the arguments specified by $args$ to the constructor of the
+	//# type of object stored in the array. No temporary object is created. The return value is a pointer to the
+	//# newly constructed element in the array.
+	//
+	//# \also	$@Array::EmplaceArrayElementAt@$
+	//# \also	$@Array::AppendArrayElement@$
+	//# \also	$@Array::InsertArrayElement@$
+
+
+	//# \function	Array::EmplaceArrayElementAt		Constructs a new object at a specific location in an array.
+	//
+	//# \proto	template <typename... T> type *EmplaceArrayElementAt(int32 index, T&&... args);
+	//
+	//# \param	index	The location at which the object is to be constructed.
+	//# \param	args	The arguments that are passed to the constructor of the new element.
+	//
+	//# \desc
+	//# The $EmplaceArrayElementAt$ function increases the size of an array by one, moves all of the existing
+	//# elements at location $index$ or greater up by one, and constructs the new element directly in the array's
+	//# storage by passing the arguments specified by $args$ to the constructor of the type of object stored in
+	//# the array. No temporary object is created. The return value is a pointer to the newly constructed element
+	//# in the array.
+	//#
+	//# If the $index$ parameter is greater than or equal to the current size of the array, then the
+	//# array is enlarged to the size $index&#x202F;+&#x202F;1$. In this case, elements between the old size and
+	//# new size are default-constructed if the type of object stored in the array is a non-POD type, and the
+	//# elements are left uninitialized if the type of object stored in the array is a POD type.
+	//
+	//# \also	$@Array::EmplaceArrayElement@$
+	//# \also	$@Array::InsertArrayElement@$
+	//# \also	$@Array::AppendArrayElement@$
+
+
 	//# \function	Array::RemoveArrayElement		Removes an object from an array.
 	//
 	//# \proto	void RemoveArrayElement(int32 index);
@@ -174,6 +269,7 @@ namespace Terathon
 	//# If the $index$ parameter is greater than or equal to the current size of the array, then
 	//# calling the $RemoveArrayElement$ function has no effect.
 	//
+	//# \also	$@Array::RemoveArrayElementUnordered@$
 	//# \also	$@Array::RemoveLastArrayElement@$
 	//# \also	$@Array::InsertArrayElement@$
 	//# \also	$@Array::AppendArrayElement@$
@@ -198,6 +294,133 @@ namespace Terathon
 	//# \also	$@Array::SetArrayElementCount@$
 
 
+	//# \function	Array::AppendArrayElements		Adds multiple objects to the end of an array.
+	//
+	//# \proto	void AppendArrayElements(const type *elements, int32 count);
+	//
+	//# \param	elements	A pointer to the objects to add to the array.
+	//# \param	count		The number of objects to add to the array.
+	//
+	//# \desc
+	//# The $AppendArrayElements$ function increases the size of an array by $count$ and copy-constructs the new
+	//# elements using the objects in the buffer specified by the $elements$ parameter. The storage for the array
+	//# is enlarged at most once, so appending a large number of elements with this function is much faster than
+	//# calling the $@Array::AppendArrayElement@$ function repeatedly. If objects of type $type$ are trivially
+	//# copyable, then the new elements are copied with a single $memcpy$ operation.
+	//#
+	//# The buffer specified by the $elements$ parameter must not be part of the array's own storage.
+	//
+	//# \also	$@Array::InsertArrayElements@$
+	//# \also	$@Array::RemoveArrayElements@$
+	//# \also	$@Array::AppendArrayElement@$
+
+
+	//# \function	Array::InsertArrayElements		Inserts multiple objects into an array.
+	//
+	//# \proto	void InsertArrayElements(int32 index, const type *elements, int32 count);
+	//
+	//# \param	index		The location at which the objects are to be inserted.
+	//# \param	elements	A pointer to the objects to insert into the array.
+	//# \param	count		The number of objects to insert into the array.
+	//
+	//# \desc
+	//# The $InsertArrayElements$ function increases the size of an array by $count$, moves all of the existing
+	//# elements at location $index$ or greater up by $count$, and copy-constructs the new elements into the array
+	//# using the objects in the buffer specified by the $elements$ parameter. The storage for the array is enlarged
+	//# at most once, and the existing elements are moved only once, regardless of the value of $count$.
+	//#
+	//# If the $index$ parameter is greater than or equal to the current size of the array, then the array is
+	//# enlarged to the size $index&#x202F;+&#x202F;count$. In this case, elements between the old size and $index$
+	//# are default-constructed if the type of object stored in the array is a non-POD type, and the elements are
+	//# left uninitialized if the type of object stored in the array is a POD type.
+	//#
+	//# The buffer specified by the $elements$ parameter must not be part of the array's own storage.
+	//
+	//# \also	$@Array::AppendArrayElements@$
+	//# \also	$@Array::RemoveArrayElements@$
+	//# \also	$@Array::InsertArrayElement@$
+
+
+	//# \function	Array::RemoveArrayElements		Removes multiple objects from an array.
+	//
+	//# \proto	void RemoveArrayElements(int32 index, int32 count);
+	//
+	//# \param	index	The location at which to begin removing objects.
+	//# \param	count	The number of objects to remove.
+	//
+	//# \desc
+	//# The $RemoveArrayElements$ function destroys the $count$ objects beginning at location $index$, moves all of the
+	//# existing elements at location $index&#x202F;+&#x202F;count$ or greater down by $count$, and decreases the size of
+	//# the array accordingly. The existing elements are moved only once, regardless of the value of $count$.
+	//#
+	//# If the range of objects to remove extends past the end of the array, then only the objects up to the end of the
+	//# array are removed. If the $index$ parameter is greater than or equal to the current size of the array, then
+	//# calling the $RemoveArrayElements$ function has no effect.
+	//
+	//# \also	$@Array::AppendArrayElements@$
+	//# \also	$@Array::InsertArrayElements@$
+	//# \also	$@Array::RemoveArrayElement@$
+	//# \also	$@Array::RemoveArrayElementsIf@$
+
+
+	//# \function	Array::RemoveArrayElementUnordered		Removes an object from an array without preserving order.
+	//
+	//# \proto	void RemoveArrayElementUnordered(int32 index);
+	//
+	//# \param	index	The location at which to remove an object.
+	//
+	//# \desc
+	//# The $RemoveArrayElementUnordered$ function decreases the size of an array by one, destroys the object at location
+	//# $index$, and moves the last element of the array into the vacated location. Only one element is moved, regardless
+	//# of the size of the array, but the order of the remaining elements is not preserved.
+	//#
+	//# If the $index$ parameter is greater than or equal to the current size of the array, then
+	//# calling the $RemoveArrayElementUnordered$ function has no effect.
+	//
+	//# \also	$@Array::RemoveArrayElementsUnordered@$
+	//# \also	$@Array::RemoveArrayElement@$
+	//# \also	$@Array::RemoveLastArrayElement@$
+
+
+	//# \function	Array::RemoveArrayElementsUnordered		Removes multiple objects from an array without preserving order.
+	//
+	//# \proto	void RemoveArrayElementsUnordered(const int32 *indexArray, int32 count);
+	//
+	//# \param	indexArray	A pointer to the locations of the objects to remove.
+	//# \param	count		The number of locations in the buffer specified by the $indexArray$ parameter.
+	//
+	//# \desc
+	//# The $RemoveArrayElementsUnordered$ function destroys the objects at the $count$ locations specified by the
+	//# $indexArray$ parameter and fills each vacated location with an element from the end of the array. At most
+	//# one element is moved for each object removed, but the order of the remaining elements is not preserved.
+	//#
+	//# The locations in the buffer specified by the $indexArray$ parameter must be sorted in increasing order, and
+	//# they must not contain any duplicates. Any location that is greater than or equal to the current size of the
+	//# array is ignored.
+	//
+	//# \also	$@Array::RemoveArrayElementUnordered@$
+	//# \also	$@Array::RemoveArrayElementsIf@$
+
+
+	//# \function	Array::RemoveArrayElementsIf		Removes all objects satisfying a condition from an array.
+	//
+	//# \proto	template <typename predicateType> int32 RemoveArrayElementsIf(predicateType&& predicate);
+	//
+	//# \param	predicate	A function object that is called with a $const$ reference to each object in the array.
+	//
+	//# \desc
+	//# The $RemoveArrayElementsIf$ function destroys every object in an array for which the $predicate$ function
+	//# returns $true$ and moves the remaining objects down to close the gaps. The order of the remaining objects is
+	//# preserved. The predicate is called exactly once for each object, in order, and each remaining object is moved
+	//# at most once, so the whole operation takes linear time. If objects of type $type$ are trivially relocatable,
+	//# then each contiguous run of remaining objects is moved with a single $memmove$ operation.
+	//#
+	//# The return value is the number of objects that were removed.
+	//
+	//# \also	$@Array::RemoveArrayElements@$
+	//# \also	$@Array::RemoveArrayElementsUnordered@$
+
+
 	//# \function	Array::ClearArray		Removes all objects from an array.
 	//
 	//# \proto	void ClearArray(void);
@@ -230,26 +453,921 @@ namespace Terathon
 	//# \also	$@Array::SetArrayElementCount@$
 
 
-	//# \function	Array::FindArrayElementIndex		Finds a specific element in an array.
-	//
-	//# \proto	int32 FindArrayElementIndex(const type& element) const;
-	//
-	//# \param	element		The value of the element to find.
-	//
-	//# \desc
-	//# The $FindArrayElementIndex$ function searches an array for the first element matching the value
-	//# passed into the $element$ parameter based on the $==$ operator. If a match is found, its index
-	//# is returned. If no match is found, then the return value is &minus;1. The running time of this
-	//# function is <i>O</i>(<i>n</i>), where <i>n</i> is the number of elements in the array.
+	//# \function	Array::ShrinkArray		Reduces the storage of an array to fit its current size.
+	//
+	//# \proto	void ShrinkArray(void);
+	//
+	//# \desc
+	//# The $ShrinkArray$ function reallocates the storage for an array so that it holds exactly the number of objects
+	//# currently in the array. If the objects fit in the storage built into the $Array$ object (as specified by the
+	//# $baseCount$ template parameter), then they are moved into it, and the heap storage is released. If the array is
+	//# empty and $baseCount$ is zero, then all of the storage is released as if $@Array::PurgeArray@$ had been called.
+	//# If the storage is already the right size, then this function has no effect.
+	//#
+	//# This function is intended for arrays that once held many more elements than they are likely to hold again.
+	//# It moves all of the objects in the array, so it invalidates pointers to them.
+	//
+	//# \also	$@Array::GetArrayReservedCount@$
+	//# \also	$@Array::PurgeArray@$
+
+
+	//# \function	Array::SwapArray		Exchanges the contents of two arrays.
+	//
+	//# \proto	void SwapArray(Array& array);
+	//
+	//# \param	array	The array whose contents are exchanged with this array.
+	//
+	//# \desc
+	//# The $SwapArray$ function exchanges the objects stored in two arrays of the same type. The allocators are
+	//# exchanged along with the storage. If both arrays keep their objects on the heap, then only the storage
+	//# pointers and counts are exchanged, and no objects are moved. If either array keeps its objects in the
+	//# storage built into the $Array$ object (as specified by the $baseCount$ template parameter), then those
+	//# objects are moved into the other array.
+	//
+	//# \also	$@Array::ShrinkArray@$
+
+
+	//# \function	Array::GetArrayReservedCount		Returns the number of objects for which storage is reserved.
+	//
+	//# \proto	int32 GetArrayReservedCount(void) const;
+	//
+	//# \desc
+	//# The $GetArrayReservedCount$ function returns the number of objects that an array can hold before its storage
+	//# needs to be reallocated. This is always at least the current size of the array.
+	//
+	//# \also	$@Array::GetArrayReservedSize@$
+	//# \also	$@Array::ShrinkArray@$
+
+
+	//# \function	Array::GetArrayReservedSize		Returns the size of the storage reserved by an array.
+	//
+	//# \proto	umachine GetArrayReservedSize(void) const;
+	//
+	//# \desc
+	//# The $GetArrayReservedSize$ function returns the size, in bytes, of the storage reserved for the objects in an
+	//# array. This includes the storage built into the $Array$ object when the objects are stored there.
+	//
+	//# \also	$@Array::GetArrayReservedCount@$
+	//# \also	$@Array::ShrinkArray@$
+
+
+	//# \function	Array::GetArrayAllocator		Returns the allocator used by an array.
+	//
+	//# \proto	allocatorType& GetArrayAllocator(void);
+	//# \proto	const allocatorType& GetArrayAllocator(void) const;
+	//
+	//# \desc
+	//# The $GetArrayAllocator$ function returns a reference to the allocator object stored inside an array. This is the
+	//# object through which all heap storage for the array is allocated and released.
+	//
+	//# \also	$@HeapArrayAllocator@$
+
+
+	//# \function	Array::FindArrayElementIndex		Finds a specific element in an array.
+	//
+	//# \proto	int32 FindArrayElementIndex(const type& element) const;
+	//
+	//# \param	element		The value of the element to find.
+	//
+	//# \desc
+	//# The $FindArrayElementIndex$ function searches an array for the first element matching the value
+	//# passed into the $element$ parameter based on the $==$ operator. If a match is found, its index
+	//# is returned. If no match is found, then the return value is &minus;1. The running time of this
+	//# function is <i>O</i>(<i>n</i>), where <i>n</i> is the number of elements in the array.
+	//#
+	//# If the type of object stored in the array is a 32-bit or 64-bit integer, a $float$, or a pointer, then the
+	//# search is performed with SSE2, AVX2, or NEON instructions that compare several elements at once whenever
+	//# the target architecture supports them.
+
+
+	//# \class	TriviallyRelocatable	Indicates whether objects of a particular type can be relocated as raw memory.
+	//
+	//# The $TriviallyRelocatable$ class template determines whether an $@Array@$ can move its elements with bulk memory copies.
+	//
+	//# \def	template <typename type> struct TriviallyRelocatable
+	//
+	//# \tparam	type	The type of the objects stored in an array.
+	//
+	//# \desc
+	//# The $TriviallyRelocatable$ class template contains a single constant member named $value$ that indicates whether
+	//# objects of the type given by the $type$ template parameter can be moved to a new location in memory by copying
+	//# their bytes and then forgetting about the old location, without calling a move constructor or destructor. When
+	//# $value$ is $true$, the $@Array@$ class moves elements with a single $memmove$ operation when its storage
+	//# is reallocated and when elements are inserted or removed.
+	//#
+	//# By default, $value$ is $true$ for all trivially copyable types. Other types that do not hold pointers into
+	//# their own storage (for example, handle types having a nontrivial destructor) can opt in by specializing the
+	//# $TriviallyRelocatable$ class template as follows.
+	//
+	//# \source
+	//# template <> struct TriviallyRelocatable<Handle>\n
+	//# {\n
+	//# \tstatic const bool value = true;\n
+	//# };
+	//
+	//# \also	$@Array@$
+
+
+	template <typename type>
+	struct TriviallyRelocatable
+	{
+		static const bool value = __is_trivially_copyable(type);
+	};
+
+
+	template <typename type>
+	void RelocateArrayElements(type *dest, type *source, machine count)
+	{
+		if (TriviallyRelocatable<type>::value)
+		{
+			MoveMemory(source, dest, sizeof(type) * count);
+		}
+		else if (dest < source)
+		{
+			for (machine a = 0; a < count; a++)
+			{
+				new(&dest[a]) type(static_cast<type&&>(source[a]));
+				source[a].~type();
+			}
+		}
+		else
+		{
+			for (machine a = count - 1; a >= 0; a--)
+			{
+				new(&dest[a]) type(static_cast<type&&>(source[a]));
+				source[a].~type();
+			}
+		}
+	}
+
+
+	template <typename type>
+	void CopyArrayElements(type *restrict dest, const type *restrict source, machine count)
+	{
+		if (__is_trivially_copyable(type))
+		{
+			CopyMemory(source, dest, sizeof(type) * count);
+		}
+		else
+		{
+			for (machine a = 0; a < count; a++)
+			{
+				new(&dest[a]) type(source[a]);
+			}
+		}
+	}
+
+
+	//# \class	HeapArrayAllocator		The default allocator used for array storage.
+	//
+	//# The $HeapArrayAllocator$ class allocates storage for an $@Array@$ object on the heap.
+	//
+	//# \def	class HeapArrayAllocator
+	//
+	//# \desc
+	//# The $HeapArrayAllocator$ class is the default value of the $allocatorType$ template parameter of the $@Array@$
+	//# class, and it allocates storage with the $new$ and $delete$ operators. A different allocator can be specified
+	//# in order to place array storage in a memory arena, a thread-local pool, or some other custom region.
+	//#
+	//# An allocator class must define the following four member functions.
+	//
+	//# \source
+	//# void *AllocateArrayStorage(umachine size);\n
+	//# void ReleaseArrayStorage(void *storage, umachine size);\n
+	//# bool ExtendArrayStorage(void *storage, umachine size, umachine newSize);\n
+	//# void *ReallocateArrayStorage(void *storage, umachine size, umachine newSize);
+	//
+	//# \desc
+	//# The $AllocateArrayStorage$ function must return a block of at least $size$ bytes that is aligned to at least
+	//# twice the size of a pointer, and the $ReleaseArrayStorage$ function must free a block previously
+	//# returned by the allocator. The $size$ parameter passed to the $ReleaseArrayStorage$ function is always the same
+	//# size that was used to allocate the block or most recently extend or reallocate it.
+	//#
+	//# When an array needs to grow, it first calls the $ExtendArrayStorage$ function to ask the allocator to enlarge
+	//# the existing block in place. If this is possible, then the function should return $true$, and the contents of
+	//# the array are not moved. Otherwise, the function should return $false$. If the objects stored in the array are
+	//# trivially relocatable (see $@TriviallyRelocatable@$), then the array next calls the $ReallocateArrayStorage$
+	//# function, which has the same semantics as the standard $realloc$ function and may move the block to a new
+	//# address. If reallocation is not supported, then the function should return $nullptr$, and the original block
+	//# must be left intact. In both cases, the array falls back to allocating a new block and moving its elements.
+	//#
+	//# An allocator may hold state. A copy of the allocator is stored inside each $Array$ object, and it is
+	//# copied or moved along with the array. A stateless allocator adds nothing to the size of an $Array$ object.
+	//
+	//# \also	$@SystemArrayAllocator@$
+	//# \also	$@Array@$
+
+
+	//# \class	SystemArrayAllocator		An allocator that uses the system $malloc$ and $realloc$ functions.
+	//
+	//# The $SystemArrayAllocator$ class allocates storage for an $@Array@$ object with the system $malloc$ function.
+	//
+	//# \def	class SystemArrayAllocator
+	//
+	//# \desc
+	//# The $SystemArrayAllocator$ class can be specified as the $allocatorType$ template parameter of the $@Array@$
+	//# class to allocate storage with the system $malloc$ function. Because such storage can be resized with the
+	//# $realloc$ function, arrays holding trivially relocatable objects can often grow without copying their contents.
+	//
+	//# \also	$@HeapArrayAllocator@$
+	//# \also	$@Array@$
+
+
+	//# \class	DefaultArrayGrowth		The default growth policy used for array storage.
+	//
+	//# The $DefaultArrayGrowth$ class increases the storage of an $@Array@$ object by about half of its current size.
+	//
+	//# \def	class DefaultArrayGrowth
+	//
+	//# \desc
+	//# The $DefaultArrayGrowth$ class is the default value of the $growthType$ template parameter of the $@Array@$ class.
+	//# Each time an array runs out of space, the reserved count is increased by half its current value rounded up to a
+	//# multiple of four, and it is increased by at least the value of the $baseCount$ template parameter (or four if
+	//# $baseCount$ is zero).
+	//#
+	//# A growth policy is a class containing the following static member function.
+	//
+	//# \source
+	//# static uint64 GetGrowthReservedCount(uint64 reservedCount, uint64 count, uint64 minimumGrowth, umachine elementSize);
+	//
+	//# \desc
+	//# The $reservedCount$ parameter is the number of elements for which storage is currently reserved, the $count$ parameter
+	//# is the number of elements that must fit in the new storage, the $minimumGrowth$ parameter is the smallest increase
+	//# that should be made to the reserved count, and the $elementSize$ parameter is the size of a single element in bytes.
+	//# The function returns the new reserved count. The array always reserves at least $count$ elements, and it clamps
+	//# the returned value so that neither the element count nor the storage size overflows, so a policy doesn't need to
+	//# handle those cases itself. If $count$ itself exceeds those limits, the array treats the request as an allocation
+	//# failure without calling the policy.
+	//
+	//# \also	$@GeometricArrayGrowth@$
+	//# \also	$@LinearArrayGrowth@$
+	//# \also	$@PowerOfTwoArrayGrowth@$
+	//# \also	$@PageArrayGrowth@$
+	//# \also	$@Array@$
+
+
+	//# \class	GeometricArrayGrowth		A growth policy that multiplies the size of array storage by a constant factor.
+	//
+	//# The $GeometricArrayGrowth$ class multiplies the storage of an $@Array@$ object by a constant factor.
+	//
+	//# \def	template <int32 numerator = 2, int32 denominator = 1> class GeometricArrayGrowth
+	//
+	//# \tparam	numerator		The numerator of the growth factor.
+	//# \tparam	denominator		The denominator of the growth factor.
+	//
+	//# \desc
+	//# The $GeometricArrayGrowth$ class can be specified as the $growthType$ template parameter of the $@Array@$ class to
+	//# multiply the reserved count by the factor $numerator$&#x202F;/&#x202F;$denominator$ each time an array runs out of
+	//# space. The factor must be greater than one. The reserved count always increases by at least the minimum growth
+	//# determined by the $baseCount$ template parameter of the array.
+	//
+	//# \also	$@DefaultArrayGrowth@$
+
+
+	//# \class	LinearArrayGrowth		A growth policy that increases the size of array storage by a constant amount.
+	//
+	//# The $LinearArrayGrowth$ class increases the storage of an $@Array@$ object by a constant number of elements.
+	//
+	//# \def	template <int32 step> class LinearArrayGrowth
+	//
+	//# \tparam	step	The number of elements by which the reserved count is increased.
+	//
+	//# \desc
+	//# The $LinearArrayGrowth$ class can be specified as the $growthType$ template parameter of the $@Array@$ class to
+	//# increase the reserved count by $step$ elements each time an array runs out of space. This wastes the least amount
+	//# of memory, but the cost of appending elements one at a time is no longer amortized constant, so this policy
+	//# should only be used for arrays whose maximum size is roughly known in advance.
+	//
+	//# \also	$@DefaultArrayGrowth@$
+
+
+	//# \class	PowerOfTwoArrayGrowth		A growth policy that keeps the size of array storage a power of two.
+	//
+	//# The $PowerOfTwoArrayGrowth$ class makes the reserved count of an $@Array@$ object a power of two.
+	//
+	//# \def	class PowerOfTwoArrayGrowth
+	//
+	//# \desc
+	//# The $PowerOfTwoArrayGrowth$ class can be specified as the $growthType$ template parameter of the $@Array@$ class to
+	//# set the reserved count to the smallest power of two that is greater than the current reserved count and large
+	//# enough to hold the new elements. This effectively doubles the storage each time an array runs out of space.
+	//
+	//# \also	$@DefaultArrayGrowth@$
+
+
+	//# \class	PageArrayGrowth		A growth policy that rounds large array storage to a multiple of the page size.
+	//
+	//# The $PageArrayGrowth$ class rounds the storage of a large $@Array@$ object up to a multiple of the page size.
+	//
+	//# \def	template <int32 pageSize = 4096, int32 thresholdSize = 65536, class growthType = DefaultArrayGrowth> class PageArrayGrowth
+	//
+	//# \tparam	pageSize		The page size, in bytes. This must be a power of two.
+	//# \tparam	thresholdSize	The storage size, in bytes, at which rounding begins.
+	//# \tparam	growthType		The growth policy that determines the reserved count before rounding.
+	//
+	//# \desc
+	//# The $PageArrayGrowth$ class can be specified as the $growthType$ template parameter of the $@Array@$ class to make
+	//# large arrays occupy whole pages. The reserved count is first calculated by the policy specified by the $growthType$
+	//# template parameter. Then, if the storage size is at least $thresholdSize$ bytes, the reserved count is increased so
+	//# that the storage size is as close to a multiple of $pageSize$ as possible. Large allocations are usually served
+	//# directly by the virtual memory system in whole pages, so this uses space at the end of the last page that would
+	//# otherwise be wasted.
+	//
+	//# \also	$@DefaultArrayGrowth@$
+
+
+	class DefaultArrayGrowth
+	{
+		public:
+
+			static uint64 GetGrowthReservedCount(uint64 reservedCount, uint64 /*count*/, uint64 minimumGrowth, umachine /*elementSize*/)
+			{
+				uint64 growth = (reservedCount / 2 + 3) & ~uint64(3);
+				return (reservedCount + ((growth > minimumGrowth) ? growth : minimumGrowth));
+			}
+	};
+
+
+	template <int32 numerator = 2, int32 denominator = 1>
+	class GeometricArrayGrowth
+	{
+		static_assert(numerator > denominator, "The growth factor must be greater than one");
+
+		public:
+
+			static uint64 GetGrowthReservedCount(uint64 reservedCount, uint64 /*count*/, uint64 minimumGrowth, umachine /*elementSize*/)
+			{
+				if (reservedCount > ~uint64(0) / numerator)
+				{
+					return (~uint64(0));
+				}
+
+				uint64 newCount = reservedCount * numerator / denominator;
+				return ((newCount - reservedCount > minimumGrowth) ? newCount : reservedCount + minimumGrowth);
+			}
+	};
+
+
+	template <int32 step>
+	class LinearArrayGrowth
+	{
+		static_assert(step > 0, "The growth step must be positive");
+
+		public:
+
+			static uint64 GetGrowthReservedCount(uint64 reservedCount, uint64 /*count*/, uint64 minimumGrowth, umachine /*elementSize*/)
+			{
+				return (reservedCount + ((uint64(step) > minimumGrowth) ? uint64(step) : minimumGrowth));
+			}
+	};
+
+
+	class PowerOfTwoArrayGrowth
+	{
+		public:
+
+			static uint64 GetGrowthReservedCount(uint64 reservedCount, uint64 count, uint64 /*minimumGrowth*/, umachine /*elementSize*/)
+			{
+				uint64 newCount = 4;
+				while ((newCount <= reservedCount) || (newCount < count))
+				{
+					if (newCount >> 63)
+					{
+						break;
+					}
+
+					newCount <<= 1;
+				}
+
+				return (newCount);
+			}
+	};
+
+
+	template <int32 pageSize = 4096, int32 thresholdSize = 65536, class growthType = DefaultArrayGrowth>
+	class PageArrayGrowth
+	{
+		static_assert((pageSize > 0) && ((pageSize & (pageSize - 1)) == 0), "The page size must be a power of two");
+
+		public:
+
+			static uint64 GetGrowthReservedCount(uint64 reservedCount, uint64 count, uint64 minimumGrowth, umachine elementSize)
+			{
+				uint64 newCount = growthType::GetGrowthReservedCount(reservedCount, count, minimumGrowth, elementSize);
+				if ((newCount < count) || (newCount > (~uint64(0) - pageSize) / elementSize))
+				{
+					return (newCount);
+				}
+
+				uint64 size = newCount * elementSize;
+				if (size < uint64(thresholdSize))
+				{
+					return (newCount);
+				}
+
+				return (((size + (pageSize - 1)) & ~uint64(pageSize - 1)) / elementSize);
+			}
+	};
+
+
+	inline void ArrayLengthFailure(void)
+	{
+		// This is the same failure that a new expression reports when the requested array length is too large.
+
+		#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+
+			throw std::bad_array_new_length();
+
+		#else
+
+			abort();
+
+		#endif
+	}
+
+
+	template <typename countType, class growthType>
+	countType CalculateArrayReservedCount(countType reservedCount, countType count, countType minimumGrowth, umachine elementSize)
+	{
+		// The reserved count can't exceed the largest value representable by countType,
+		// and the total size of the storage can't exceed the largest value representable
+		// by umachine. Growth is clamped to both limits instead of being allowed to wrap, and a
+		// requested count beyond them can't be satisfied at all.
+
+		uint64 limit = ~uint64(0) >> (65 - sizeof(countType) * 8);
+		umachine sizeLimit = ~umachine(0) / elementSize;
+		if (uint64(sizeLimit) < limit)
+		{
+			limit = uint64(sizeLimit);
+		}
+
+		if (uint64(count) > limit)
+		{
+			ArrayLengthFailure();
+		}
+
+		uint64 newCount = growthType::GetGrowthReservedCount(uint64(reservedCount), uint64(count), uint64(minimumGrowth), elementSize);
+		if (newCount > limit)
+		{
+			newCount = limit;
+		}
+
+		if (newCount < uint64(count))
+		{
+			newCount = uint64(count);
+		}
+
+		return (countType((newCount > 4) ? newCount : 4));
+	}
+
+
+	enum
+	{
+		kArrayAllocatorAlignment = sizeof(void *) * 2
+	};
+
+
+	template <typename type, int32 alignment>
+	struct ArrayAlignment
+	{
+		static_assert((alignment & (alignment - 1)) == 0, "Array alignment must be a power of two");
+
+		static const umachine value = (umachine(alignment) > alignof(type)) ? umachine(alignment) : alignof(type);
+	};
+
+
+	template <class allocatorType, umachine alignment, bool overaligned = (alignment > kArrayAllocatorAlignment)>
+	class AlignedArrayStorage
+	{
+		// Allocators already return blocks aligned to kArrayAllocatorAlignment, so only
+		// the tail needs to be padded to a multiple of the alignment.
+
+		public:
+
+			static umachine GetPaddedSize(umachine size)
+			{
+				return ((size + (alignment - 1)) & ~(alignment - 1));
+			}
+
+			static void *AllocateArrayStorage(allocatorType *allocator, umachine size)
+			{
+				return (allocator->AllocateArrayStorage(GetPaddedSize(size)));
+			}
+
+			static void ReleaseArrayStorage(allocatorType *allocator, void *storage, umachine size)
+			{
+				allocator->ReleaseArrayStorage(storage, GetPaddedSize(size));
+			}
+
+			static bool ExtendArrayStorage(allocatorType *allocator, void *storage, umachine size, umachine newSize)
+			{
+				return (allocator->ExtendArrayStorage(storage, GetPaddedSize(size), GetPaddedSize(newSize)));
+			}
+
+			static void *ReallocateArrayStorage(allocatorType *allocator, void *storage, umachine size, umachine newSize)
+			{
+				return (allocator->ReallocateArrayStorage(storage, GetPaddedSize(size), GetPaddedSize(newSize)));
+			}
+	};
+
+
+	template <class allocatorType, umachine alignment>
+	class AlignedArrayStorage<allocatorType, alignment, true>
+	{
+		// The block is enlarged by the alignment so that an aligned address can always be found
+		// inside it, and the original address is stored in the pointer just below the aligned one.
+		// The alignment is at least twice the size of a pointer, so there is always room for it.
+
+		public:
+
+			static umachine GetPaddedSize(umachine size)
+			{
+				return (((size + (alignment - 1)) & ~(alignment - 1)) + alignment);
+			}
+
+			static void *AllocateArrayStorage(allocatorType *allocator, umachine size)
+			{
+				char *storage = static_cast<char *>(allocator->AllocateArrayStorage(GetPaddedSize(size)));
+				char *aligned = reinterpret_cast<char *>((reinterpret_cast<machine_address>(storage) & ~machine_address(alignment - 1)) + alignment);
+				reinterpret_cast<char **>(aligned)[-1] = storage;
+				return (aligned);
+			}
+
+			static void ReleaseArrayStorage(allocatorType *allocator, void *storage, umachine size)
+			{
+				allocator->ReleaseArrayStorage(static_cast<char **>(storage)[-1], GetPaddedSize(size));
+			}
+
+			static bool ExtendArrayStorage(allocatorType *allocator, void *storage, umachine size, umachine newSize)
+			{
+				// The original block doesn't move when it's extended, so the aligned address stays the same.
+
+				return (allocator->ExtendArrayStorage(static_cast<char **>(storage)[-1], GetPaddedSize(size), GetPaddedSize(newSize)));
+			}
+
+			static void *ReallocateArrayStorage(allocatorType * /*allocator*/, void * /*storage*/, umachine /*size*/, umachine /*newSize*/)
+			{
+				// A reallocated block could have a different offset to the next aligned address,
+				// so reallocation isn't used, and the array falls back to allocating a new block.
+
+				return (nullptr);
+			}
+	};
+
+
+	class HeapArrayAllocator
+	{
+		public:
+
+			void *AllocateArrayStorage(umachine size)
+			{
+				return (new char[size]);
+			}
+
+			void ReleaseArrayStorage(void *storage, umachine /*size*/)
+			{
+				delete[] static_cast<char *>(storage);
+			}
+
+			bool ExtendArrayStorage(void * /*storage*/, umachine /*size*/, umachine /*newSize*/)
+			{
+				return (false);
+			}
+
+			void *ReallocateArrayStorage(void * /*storage*/, umachine /*size*/, umachine /*newSize*/)
+			{
+				return (nullptr);
+			}
+	};
+
+
+	#ifndef TERATHON_NO_SYSTEM
+
+		class SystemArrayAllocator
+		{
+			public:
+
+				void *AllocateArrayStorage(umachine size)
+				{
+					return (malloc(size));
+				}
+
+				void ReleaseArrayStorage(void *storage, umachine /*size*/)
+				{
+					free(storage);
+				}
+
+				bool ExtendArrayStorage(void * /*storage*/, umachine /*size*/, umachine /*newSize*/)
+				{
+					return (false);
+				}
+
+				void *ReallocateArrayStorage(void *storage, umachine /*size*/, umachine newSize)
+				{
+					return (realloc(storage, newSize));
+				}
+		};
+
+	#endif
+
+
+	enum
+	{
+		kArraySearchGeneric,
+		kArraySearchInteger32,
+		kArraySearchInteger64,
+		kArraySearchFloat
+	};
+
+
+	//# \class	BitwiseComparable	Indicates whether objects of a particular type can be compared as raw memory.
+	//
+	//# The $BitwiseComparable$ class template determines whether arrays can be compared with a single $memcmp$ operation.
+	//
+	//# \def	template <typename type> struct BitwiseComparable
+	//
+	//# \tparam		type	The type of the objects stored in an array.
+	//
+	//# \desc
+	//# The $BitwiseComparable$ class template contains a single constant member named $value$ that indicates whether
+	//# two objects of the type given by the $type$ template parameter are equal exactly when their bytes are equal.
+	//# When $value$ is $true$, the $==$ operator for arrays compares the contents of two arrays with a single $memcmp$
+	//# operation instead of calling the $!=$ operator for each pair of elements.
+	//#
+	//# By default, $value$ is $true$ for all integer types and pointer types. It is $false$ for floating-point types
+	//# because positive and negative zero compare equal and NaNs compare unequal. Structures that contain no padding
+	//# and whose equality operator compares all members bitwise can opt in by specializing the $BitwiseComparable$
+	//# class template.
+	//
+	//# \also	$@Array@$
+
+
+	template <typename type>
+	struct BitwiseComparable
+	{
+		static const bool value = false;
+	};
+
+	template <typename type>
+	struct BitwiseComparable<type *>
+	{
+		static const bool value = true;
+	};
+
+	template <> struct BitwiseComparable<bool> {static const bool value = true;};
+	template <> struct BitwiseComparable<char> {static const bool value = true;};
+	template <> struct BitwiseComparable<int8> {static const bool value = true;};
+	template <> struct BitwiseComparable<uint8> {static const bool value = true;};
+	template <> struct BitwiseComparable<int16> {static const bool value = true;};
+	template <> struct BitwiseComparable<uint16> {static const bool value = true;};
+	template <> struct BitwiseComparable<int32> {static const bool value = true;};
+	template <> struct BitwiseComparable<uint32> {static const bool value = true;};
+	template <> struct BitwiseComparable<int64> {static const bool value = true;};
+	template <> struct BitwiseComparable<uint64> {static const bool value = true;};
+
+
+	template <typename type>
+	struct ArraySearchType
+	{
+		static const int32 value = kArraySearchGeneric;
+	};
+
+	template <typename type>
+	struct ArraySearchType<type *>
+	{
+		static const int32 value = (sizeof(type *) == 8) ? kArraySearchInteger64 : kArraySearchInteger32;
+	};
+
+	template <> struct ArraySearchType<int32> {static const int32 value = kArraySearchInteger32;};
+	template <> struct ArraySearchType<uint32> {static const int32 value = kArraySearchInteger32;};
+	template <> struct ArraySearchType<int64> {static const int32 value = kArraySearchInteger64;};
+	template <> struct ArraySearchType<uint64> {static const int32 value = kArraySearchInteger64;};
+	template <> struct ArraySearchType<float> {static const int32 value = kArraySearchFloat;};
+
+
+	inline machine FindArrayElement32(const uint32 *array, machine count, uint32 value)
+	{
+		machine a = 0;
+
+		#if TERATHON_AVX2
+
+			__m256i v = _mm256_set1_epi32(int32(value));
+			for (; a + 8 <= count; a += 8)
+			{
+				__m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(array + a)), v);
+				uint32 mask = _mm256_movemask_ps(_mm256_castsi256_ps(c));
+				if (mask != 0)
+				{
+					return (a + Cnttz(mask));
+				}
+			}
+
+		#elif TERATHON_SSE2
+
+			__m128i v = _mm_set1_epi32(int32(value));
+			for (; a + 8 <= count; a += 8)
+			{
+				__m128i c1 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(array + a)), v);
+				__m128i c2 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(array + a + 4)), v);
+				uint32 mask = _mm_movemask_ps(_mm_castsi128_ps(c1)) | (_mm_movemask_ps(_mm_castsi128_ps(c2)) << 4);
+				if (mask != 0)
+				{
+					return (a + Cnttz(mask));
+				}
+			}
+
+		#elif TERATHON_NEON
+
+			uint32x4_t v = vdupq_n_u32(value);
+			for (; a + 4 <= count; a += 4)
+			{
+				uint32x4_t c = vceqq_u32(vld1q_u32(array + a), v);
+				uint64 mask = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(c)), 0);
+				if (mask != 0)
+				{
+					return (a + (Cnttz64(mask) >> 4));
+				}
+			}
+
+		#endif
+
+		for (; a < count; a++)
+		{
+			if (array[a] == value)
+			{
+				return (a);
+			}
+		}
+
+		return (-1);
+	}
+
+	inline machine FindArrayElement64(const uint64 *array, machine count, uint64 value)
+	{
+		machine a = 0;
+
+		#if TERATHON_AVX2
+
+			__m256i v = _mm256_set1_epi64x(int64(value));
+			for (; a + 4 <= count; a += 4)
+			{
+				__m256i c = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(array + a)), v);
+				uint32 mask = _mm256_movemask_pd(_mm256_castsi256_pd(c));
+				if (mask != 0)
+				{
+					return (a + Cnttz(mask));
+				}
+			}
+
+		#elif TERATHON_SSE2
+
+			__m128i v = _mm_set1_epi64x(int64(value));
+			for (; a + 2 <= count; a += 2)
+			{
+				// SSE2 has no 64-bit equality test, so both 32-bit halves of each element must match.
+
+				__m128i c = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(array + a)), v);
+				c = _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+				uint32 mask = _mm_movemask_pd(_mm_castsi128_pd(c));
+				if (mask != 0)
+				{
+					return (a + Cnttz(mask));
+				}
+			}
+
+		#elif TERATHON_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+
+			uint64x2_t v = vdupq_n_u64(value);
+			for (; a + 2 <= count; a += 2)
+			{
+				uint64x2_t c = vceqq_u64(vld1q_u64(array + a), v);
+				uint64 mask = vget_lane_u64(vreinterpret_u64_u32(vmovn_u64(c)), 0);
+				if (mask != 0)
+				{
+					return (a + (Cnttz64(mask) >> 5));
+				}
+			}
+
+		#endif
+
+		for (; a < count; a++)
+		{
+			if (array[a] == value)
+			{
+				return (a);
+			}
+		}
+
+		return (-1);
+	}
+
+	inline machine FindArrayElementFloat(const float *array, machine count, float value)
+	{
+		machine a = 0;
+
+		#if TERATHON_AVX2
+
+			__m256 v = _mm256_set1_ps(value);
+			for (; a + 8 <= count; a += 8)
+			{
+				uint32 mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(array + a), v, _CMP_EQ_OQ));
+				if (mask != 0)
+				{
+					return (a + Cnttz(mask));
+				}
+			}
+
+		#elif TERATHON_SSE2
+
+			__m128 v = _mm_set1_ps(value);
+			for (; a + 8 <= count; a += 8)
+			{
+				uint32 mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(array + a), v)) | (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(array + a + 4), v)) << 4);
+				if (mask != 0)
+				{
+					return (a + Cnttz(mask));
+				}
+			}
+
+		#elif TERATHON_NEON
+
+			float32x4_t v = vdupq_n_f32(value);
+			for (; a + 4 <= count; a += 4)
+			{
+				uint32x4_t c = vceqq_f32(vld1q_f32(array + a), v);
+				uint64 mask = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(c)), 0);
+				if (mask != 0)
+				{
+					return (a + (Cnttz64(mask) >> 4));
+				}
+			}
+
+		#endif
+
+		for (; a < count; a++)
+		{
+			if (array[a] == value)
+			{
+				return (a);
+			}
+		}
+
+		return (-1);
+	}
+
+
+	template <typename type, int32 searchType = ArraySearchType<type>::value>
+	struct ArraySearch
+	{
+		static machine FindArrayElement(const type *array, machine count, const type& element)
+		{
+			for (machine a = 0; a < count; a++)
+			{
+				if (array[a] == element)
+				{
+					return (a);
+				}
+			}
 
+			return (-1);
+		}
+	};
+
+	template <typename type>
+	struct ArraySearch<type, kArraySearchInteger32>
+	{
+		static machine FindArrayElement(const type *array, machine count, const type& element)
+		{
+			return (FindArrayElement32(reinterpret_cast<const uint32 *>(array), count, reinterpret_cast<const uint32&>(element)));
+		}
+	};
 
 	template <typename type>
+	struct ArraySearch<type, kArraySearchInteger64>
+	{
+		static machine FindArrayElement(const type *array, machine count, const type& element)
+		{
+			return (FindArrayElement64(reinterpret_cast<const uint64 *>(array), count, reinterpret_cast<const uint64&>(element)));
+		}
+	};
+
+	template <typename type>
+	struct ArraySearch<type, kArraySearchFloat>
+	{
+		static machine FindArrayElement(const type *array, machine count, const type& element)
+		{
+			return (FindArrayElementFloat(array, count, element));
+		}
+	};
+
+
+	template <typename type, typename countType = int32>
 	class ImmutableArray
 	{
 		protected:
 
-			int32		elementCount;
-			int32		reservedCount;
+			countType	elementCount;
+			countType	reservedCount;
 
 			type		*arrayPointer;
 
@@ -284,39 +1402,36 @@ namespace Terathon
 				return (elementCount == 0);
 			}
 
-			int32 GetArrayElementCount(void) const
+			countType GetArrayElementCount(void) const
 			{
 				return (elementCount);
 			}
 
-			int32 FindArrayElementIndex(const type& element) const;
+			countType FindArrayElementIndex(const type& element) const;
 
 			bool operator ==(const ImmutableArray& array) const;
 	};
 
-	template <typename type>
-	int32 ImmutableArray<type>::FindArrayElementIndex(const type& element) const
+	template <typename type, typename countType>
+	countType ImmutableArray<type, countType>::FindArrayElementIndex(const type& element) const
 	{
-		for (machine a = 0; a < elementCount; a++)
-		{
-			if (arrayPointer[a] == element)
-			{
-				return (int32(a));
-			}
-		}
-
-		return (-1);
+		return (countType(ArraySearch<type>::FindArrayElement(arrayPointer, elementCount, element)));
 	}
 
-	template <typename type>
-	bool ImmutableArray<type>::operator ==(const ImmutableArray<type>& array) const
+	template <typename type, typename countType>
+	bool ImmutableArray<type, countType>::operator ==(const ImmutableArray<type, countType>& array) const
 	{
-		int32 count = elementCount;
+		countType count = elementCount;
 		if (count != array.elementCount)
 		{
 			return (false);
 		}
 
+		if (BitwiseComparable<type>::value)
+		{
+			return ((count == 0) || (memcmp(arrayPointer, array.arrayPointer, sizeof(type) * count) == 0));
+		}
+
 		for (machine a = 0; a < count; a++)
 		{
 			if (arrayPointer[a] != array.arrayPointer[a])
@@ -329,62 +1444,114 @@ namespace Terathon
 	}
 
 
-	template <typename type, int32 baseCount = 0>
-	class Array final : public ImmutableArray<type>
+	template <typename type, int32 baseCount = 0, class allocatorType = HeapArrayAllocator, typename countType = int32, class growthType = DefaultArrayGrowth, int32 alignment = 0>
+	class Array final : private allocatorType, public ImmutableArray<type, countType>
 	{
 		private:
 
-			using ImmutableArray<type>::elementCount;
-			using ImmutableArray<type>::reservedCount;
-			using ImmutableArray<type>::arrayPointer;
+			using ImmutableArray<type, countType>::elementCount;
+			using ImmutableArray<type, countType>::reservedCount;
+			using ImmutableArray<type, countType>::arrayPointer;
 
-			alignas(type) char		arrayStorage[baseCount * sizeof(type)];
+			static const umachine kStorageAlignment = ArrayAlignment<type, alignment>::value;
+			typedef AlignedArrayStorage<allocatorType, kStorageAlignment> storageType;
 
-			void SetReservedCount(int32 count);
+			alignas(kStorageAlignment) char		arrayStorage[(baseCount * sizeof(type) + (kStorageAlignment - 1)) & ~(kStorageAlignment - 1)];
+
+			void SetReservedCount(countType count);
 
 		public:
 
 			explicit Array();
+			explicit Array(const allocatorType& allocator);
 			Array(const Array& array);
 			Array(Array&& array);
 			~Array();
 
+			Array& operator =(const Array& array);
+			Array& operator =(Array&& array);
+
+			allocatorType& GetArrayAllocator(void)
+			{
+				return (*this);
+			}
+
+			const allocatorType& GetArrayAllocator(void) const
+			{
+				return (*this);
+			}
+
+			countType GetArrayReservedCount(void) const
+			{
+				return (reservedCount);
+			}
+
+			umachine GetArrayReservedSize(void) const
+			{
+				return (sizeof(type) * reservedCount);
+			}
+
 			void ClearArray(void);
 			void PurgeArray(void);
-			void ReserveArrayElementCount(int32 count);
+			void ShrinkArray(void);
+			void SwapArray(Array& array);
+			void ReserveArrayElementCount(countType count);
 
-			void SetArrayElementCount(int32 count);
-			void SetArrayElementCount(int32 count, const type& init);
+			void SetArrayElementCount(countType count);
+			void SetArrayElementCount(countType count, const type& init);
 			type *AppendArrayElement(void);
 
 			template <typename T>
 			type *AppendArrayElement(T&& element);
 
 			template <typename T>
-			void InsertArrayElement(int32 index, T&& element);
+			void InsertArrayElement(countType index, T&& element);
+
+			template <typename... T>
+			type *EmplaceArrayElement(T&&... args);
+
+			template <typename... T>
+			type *EmplaceArrayElementAt(countType index, T&&... args);
 
-			void RemoveArrayElement(int32 index);
+			void RemoveArrayElement(countType index);
+			void RemoveArrayElementUnordered(countType index);
 			void RemoveLastArrayElement(void);
+
+			void AppendArrayElements(const type *elements, countType count);
+			void InsertArrayElements(countType index, const type *elements, countType count);
+			void RemoveArrayElements(countType index, countType count);
+			void RemoveArrayElementsUnordered(const countType *indexArray, countType count);
+
+			template <typename predicateType>
+			countType RemoveArrayElementsIf(predicateType&& predicate);
 	};
 
 
-	template <typename type, int32 baseCount>
-	Array<type, baseCount>::Array()
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, baseCount, allocatorType, countType, growthType, alignment>::Array()
+	{
+		elementCount = 0;
+		reservedCount = baseCount;
+		arrayPointer = reinterpret_cast<type *>(arrayStorage);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, baseCount, allocatorType, countType, growthType, alignment>::Array(const allocatorType& allocator) : allocatorType(allocator)
 	{
 		elementCount = 0;
 		reservedCount = baseCount;
 		arrayPointer = reinterpret_cast<type *>(arrayStorage);
 	}
 
-	template <typename type, int32 baseCount>
-	Array<type, baseCount>::Array(const Array& array)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, baseCount, allocatorType, countType, growthType, alignment>::Array(const Array& array) : allocatorType(array), ImmutableArray<type, countType>()
 	{
 		elementCount = array.elementCount;
 
 		if (elementCount > baseCount)
 		{
 			reservedCount = array.reservedCount;
-			arrayPointer = reinterpret_cast<type *>(new char[sizeof(type) * reservedCount]);
+			arrayPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, sizeof(type) * reservedCount));
 		}
 		else
 		{
@@ -398,8 +1565,8 @@ namespace Terathon
 		}
 	}
 
-	template <typename type, int32 baseCount>
-	Array<type, baseCount>::Array(Array&& array)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, baseCount, allocatorType, countType, growthType, alignment>::Array(Array&& array) : allocatorType(static_cast<allocatorType&&>(array))
 	{
 		elementCount = array.elementCount;
 
@@ -413,12 +1580,7 @@ namespace Terathon
 			reservedCount = baseCount;
 			arrayPointer = reinterpret_cast<type *>(arrayStorage);
 
-			type *pointer = array.arrayPointer;
-			for (machine a = 0; a < elementCount; a++)
-			{
-				new(&arrayPointer[a]) type(static_cast<type&&>(pointer[a]));
-				pointer[a].~type();
-			}
+			RelocateArrayElements(arrayPointer, array.arrayPointer, elementCount);
 		}
 
 		array.elementCount = 0;
@@ -426,8 +1588,8 @@ namespace Terathon
 		array.arrayPointer = reinterpret_cast<type *>(array.arrayStorage);
 	}
 
-	template <typename type, int32 baseCount>
-	Array<type, baseCount>::~Array()
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, baseCount, allocatorType, countType, growthType, alignment>::~Array()
 	{
 		type *pointer = arrayPointer + elementCount;
 		for (machine a = elementCount - 1; a >= 0; a--)
@@ -435,15 +1597,75 @@ namespace Terathon
 			(--pointer)->~type();
 		}
 
-		char *ptr = reinterpret_cast<char *>(arrayPointer);
-		if (ptr != arrayStorage)
+		if (reinterpret_cast<char *>(arrayPointer) != arrayStorage)
+		{
+			storageType::ReleaseArrayStorage(this, arrayPointer, sizeof(type) * reservedCount);
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, baseCount, allocatorType, countType, growthType, alignment>& Array<type, baseCount, allocatorType, countType, growthType, alignment>::operator =(const Array& array)
+	{
+		if (this != &array)
+		{
+			// The existing storage is kept if it is large enough, so repeatedly assigning
+			// arrays of similar size doesn't allocate anything.
+
+			ClearArray();
+
+			countType count = array.elementCount;
+			if (count > reservedCount)
+			{
+				SetReservedCount(count);
+			}
+
+			CopyArrayElements(arrayPointer, array.arrayPointer, count);
+			elementCount = count;
+		}
+
+		return (*this);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, baseCount, allocatorType, countType, growthType, alignment>& Array<type, baseCount, allocatorType, countType, growthType, alignment>::operator =(Array&& array)
+	{
+		if (this != &array)
 		{
-			delete[] ptr;
+			ClearArray();
+
+			countType count = array.elementCount;
+			if (reinterpret_cast<char *>(array.arrayPointer) != array.arrayStorage)
+			{
+				if (reinterpret_cast<char *>(arrayPointer) != arrayStorage)
+				{
+					storageType::ReleaseArrayStorage(this, arrayPointer, sizeof(type) * reservedCount);
+				}
+
+				allocatorType::operator =(static_cast<allocatorType&&>(array));
+
+				reservedCount = array.reservedCount;
+				arrayPointer = array.arrayPointer;
+
+				array.reservedCount = baseCount;
+				array.arrayPointer = reinterpret_cast<type *>(array.arrayStorage);
+			}
+			else
+			{
+				// The elements are in the other array's built-in storage, so they have to be moved
+				// individually. They always fit in this array's storage, whichever kind it is.
+
+				RelocateArrayElements(arrayPointer, array.arrayPointer, count);
+			}
+
+			elementCount = count;
+			array.elementCount = 0;
 		}
+
+		return (*this);
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::ClearArray(void)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::ClearArray(void)
 	{
 		type *pointer = arrayPointer + elementCount;
 		for (machine a = elementCount - 1; a >= 0; a--)
@@ -454,8 +1676,8 @@ namespace Terathon
 		elementCount = 0;
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::PurgeArray(void)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::PurgeArray(void)
 	{
 		type *pointer = arrayPointer + elementCount;
 		for (machine a = elementCount - 1; a >= 0; a--)
@@ -463,10 +1685,9 @@ namespace Terathon
 			(--pointer)->~type();
 		}
 
-		char *ptr = reinterpret_cast<char *>(arrayPointer);
-		if (ptr != arrayStorage)
+		if (reinterpret_cast<char *>(arrayPointer) != arrayStorage)
 		{
-			delete[] ptr;
+			storageType::ReleaseArrayStorage(this, arrayPointer, sizeof(type) * reservedCount);
 		}
 
 		elementCount = 0;
@@ -474,31 +1695,120 @@ namespace Terathon
 		arrayPointer = reinterpret_cast<type *>(arrayStorage);
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::SetReservedCount(int32 count)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::ShrinkArray(void)
 	{
-		reservedCount = Max(Max(count, 4), reservedCount + Max((reservedCount / 2 + 3) & ~3, baseCount));
-		type *newPointer = reinterpret_cast<type *>(new char[sizeof(type) * reservedCount]);
+		if ((reinterpret_cast<char *>(arrayPointer) == arrayStorage) || (elementCount == reservedCount))
+		{
+			return;
+		}
 
-		type *pointer = arrayPointer;
-		for (machine a = 0; a < elementCount; a++)
+		umachine size = sizeof(type) * reservedCount;
+		if (elementCount <= baseCount)
 		{
-			new(&newPointer[a]) type(static_cast<type&&>(*pointer));
-			pointer->~type();
-			pointer++;
+			type *newPointer = reinterpret_cast<type *>(arrayStorage);
+			RelocateArrayElements(newPointer, arrayPointer, elementCount);
+			storageType::ReleaseArrayStorage(this, arrayPointer, size);
+
+			reservedCount = baseCount;
+			arrayPointer = newPointer;
+			return;
+		}
+
+		umachine newSize = sizeof(type) * elementCount;
+		if (TriviallyRelocatable<type>::value)
+		{
+			void *storage = storageType::ReallocateArrayStorage(this, arrayPointer, size, newSize);
+			if (storage)
+			{
+				arrayPointer = static_cast<type *>(storage);
+				reservedCount = elementCount;
+				return;
+			}
+		}
+
+		type *newPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, newSize));
+		RelocateArrayElements(newPointer, arrayPointer, elementCount);
+		storageType::ReleaseArrayStorage(this, arrayPointer, size);
+
+		reservedCount = elementCount;
+		arrayPointer = newPointer;
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::SwapArray(Array& array)
+	{
+		if ((reinterpret_cast<char *>(arrayPointer) != arrayStorage) && (reinterpret_cast<char *>(array.arrayPointer) != array.arrayStorage))
+		{
+			allocatorType allocator(static_cast<allocatorType&&>(*this));
+			allocatorType::operator =(static_cast<allocatorType&&>(array));
+			static_cast<allocatorType&>(array) = static_cast<allocatorType&&>(allocator);
+
+			countType count = elementCount;
+			elementCount = array.elementCount;
+			array.elementCount = count;
+
+			count = reservedCount;
+			reservedCount = array.reservedCount;
+			array.reservedCount = count;
+
+			type *pointer = arrayPointer;
+			arrayPointer = array.arrayPointer;
+			array.arrayPointer = pointer;
+		}
+		else if (this != &array)
+		{
+			// At least one of the arrays uses its built-in storage, so elements stored there
+			// have to be moved, but heap storage is still transferred without copying.
+
+			Array temp(static_cast<Array&&>(array));
+			array = static_cast<Array&&>(*this);
+			*this = static_cast<Array&&>(temp);
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::SetReservedCount(countType count)
+	{
+		countType newReservedCount = CalculateArrayReservedCount<countType, growthType>(reservedCount, count, baseCount, sizeof(type));
+		umachine size = sizeof(type) * reservedCount;
+		umachine newSize = sizeof(type) * newReservedCount;
+
+		bool heapStorage = (reinterpret_cast<char *>(arrayPointer) != arrayStorage);
+		if (heapStorage)
+		{
+			if (storageType::ExtendArrayStorage(this, arrayPointer, size, newSize))
+			{
+				reservedCount = newReservedCount;
+				return;
+			}
+
+			if (TriviallyRelocatable<type>::value)
+			{
+				void *storage = storageType::ReallocateArrayStorage(this, arrayPointer, size, newSize);
+				if (storage)
+				{
+					arrayPointer = static_cast<type *>(storage);
+					reservedCount = newReservedCount;
+					return;
+				}
+			}
 		}
 
-		char *ptr = reinterpret_cast<char *>(arrayPointer);
-		if (ptr != arrayStorage)
+		type *newPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, newSize));
+		RelocateArrayElements(newPointer, arrayPointer, elementCount);
+
+		if (heapStorage)
 		{
-			delete[] ptr;
+			storageType::ReleaseArrayStorage(this, arrayPointer, size);
 		}
 
+		reservedCount = newReservedCount;
 		arrayPointer = newPointer;
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::ReserveArrayElementCount(int32 count)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::ReserveArrayElementCount(countType count)
 	{
 		if (count > reservedCount)
 		{
@@ -506,8 +1816,8 @@ namespace Terathon
 		}
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::SetArrayElementCount(int32 count)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::SetArrayElementCount(countType count)
 	{
 		if (count > reservedCount)
 		{
@@ -534,8 +1844,8 @@ namespace Terathon
 		elementCount = count;
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::SetArrayElementCount(int32 count, const type& init)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::SetArrayElementCount(countType count, const type& init)
 	{
 		if (count > reservedCount)
 		{
@@ -562,8 +1872,8 @@ namespace Terathon
 		elementCount = count;
 	}
 
-	template <typename type, int32 baseCount>
-	type *Array<type, baseCount>::AppendArrayElement(void)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	type *Array<type, baseCount, allocatorType, countType, growthType, alignment>::AppendArrayElement(void)
 	{
 		if (elementCount >= reservedCount)
 		{
@@ -577,9 +1887,9 @@ namespace Terathon
 		return (pointer);
 	}
 
-	template <typename type, int32 baseCount>
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
 	template <typename T>
-	type *Array<type, baseCount>::AppendArrayElement(T&& element)
+	type *Array<type, baseCount, allocatorType, countType, growthType, alignment>::AppendArrayElement(T&& element)
 	{
 		if (elementCount >= reservedCount)
 		{
@@ -589,20 +1899,166 @@ namespace Terathon
 		type *pointer = arrayPointer + elementCount;
 		new(pointer) type(static_cast<T&&>(element));
 
-		elementCount++;
-		return (pointer);
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	template <typename T>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::InsertArrayElement(countType index, T&& element)
+	{
+		if (index >= elementCount)
+		{
+			countType count = index + 1;
+			if (count > reservedCount)
+			{
+				SetReservedCount(count);
+			}
+
+			type *pointer = &arrayPointer[elementCount - 1];
+			for (machine a = elementCount; a < index; a++)
+			{
+				new(++pointer) type;
+			}
+
+			new (++pointer) type(static_cast<T&&>(element));
+			elementCount = count;
+		}
+		else
+		{
+			countType count = elementCount + 1;
+			if (count > reservedCount)
+			{
+				SetReservedCount(count);
+			}
+
+			type *pointer = &arrayPointer[index];
+			RelocateArrayElements(pointer + 1, pointer, elementCount - index);
+
+			new (pointer) type(static_cast<T&&>(element));
+			elementCount = count;
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	template <typename... T>
+	type *Array<type, baseCount, allocatorType, countType, growthType, alignment>::EmplaceArrayElement(T&&... args)
+	{
+		if (elementCount >= reservedCount)
+		{
+			SetReservedCount(elementCount + 1);
+		}
+
+		type *pointer = arrayPointer + elementCount;
+		new(pointer) type(static_cast<T&&>(args)...);
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	template <typename... T>
+	type *Array<type, baseCount, allocatorType, countType, growthType, alignment>::EmplaceArrayElementAt(countType index, T&&... args)
+	{
+		if (index >= elementCount)
+		{
+			countType count = index + 1;
+			if (count > reservedCount)
+			{
+				SetReservedCount(count);
+			}
+
+			type *pointer = &arrayPointer[elementCount - 1];
+			for (machine a = elementCount; a < index; a++)
+			{
+				new(++pointer) type;
+			}
+
+			new(++pointer) type(static_cast<T&&>(args)...);
+			elementCount = count;
+			return (pointer);
+		}
+
+		countType count = elementCount + 1;
+		if (count > reservedCount)
+		{
+			SetReservedCount(count);
+		}
+
+		type *pointer = &arrayPointer[index];
+		RelocateArrayElements(pointer + 1, pointer, elementCount - index);
+
+		new(pointer) type(static_cast<T&&>(args)...);
+		elementCount = count;
+		return (pointer);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::RemoveArrayElement(countType index)
+	{
+		if (index < elementCount)
+		{
+			type *pointer = &arrayPointer[index];
+			pointer->~type();
+
+			RelocateArrayElements(pointer, pointer + 1, elementCount - index - 1);
+			elementCount--;
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::RemoveArrayElementUnordered(countType index)
+	{
+		if (index < elementCount)
+		{
+			type *pointer = &arrayPointer[index];
+			pointer->~type();
+
+			countType last = elementCount - 1;
+			if (index != last)
+			{
+				RelocateArrayElements(pointer, &arrayPointer[last], 1);
+			}
+
+			elementCount = last;
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::RemoveLastArrayElement(void)
+	{
+		countType index = elementCount - 1;
+		if (index >= 0)
+		{
+			type *pointer = &arrayPointer[index];
+			pointer->~type();
+
+			elementCount = index;
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::AppendArrayElements(const type *elements, countType count)
+	{
+		countType newCount = elementCount + count;
+		if (newCount > reservedCount)
+		{
+			SetReservedCount(newCount);
+		}
+
+		CopyArrayElements(arrayPointer + elementCount, elements, count);
+		elementCount = newCount;
 	}
 
-	template <typename type, int32 baseCount>
-	template <typename T>
-	void Array<type, baseCount>::InsertArrayElement(int32 index, T&& element)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::InsertArrayElements(countType index, const type *elements, countType count)
 	{
 		if (index >= elementCount)
 		{
-			int32 count = index + 1;
-			if (count > reservedCount)
+			countType newCount = index + count;
+			if (newCount > reservedCount)
 			{
-				SetReservedCount(count);
+				SetReservedCount(newCount);
 			}
 
 			type *pointer = &arrayPointer[elementCount - 1];
@@ -611,116 +2067,206 @@ namespace Terathon
 				new(++pointer) type;
 			}
 
-			new (++pointer) type(static_cast<T&&>(element));
-			elementCount = count;
+			CopyArrayElements(pointer + 1, elements, count);
+			elementCount = newCount;
 		}
-		else
+		else if (count > 0)
 		{
-			int32 count = elementCount + 1;
-			if (count > reservedCount)
+			countType newCount = elementCount + count;
+			if (newCount > reservedCount)
 			{
-				SetReservedCount(count);
+				SetReservedCount(newCount);
 			}
 
-			type *pointer = &arrayPointer[elementCount];
-			for (machine a = elementCount; a > index; a--)
-			{
-				new(pointer) type(static_cast<type&&>(pointer[-1]));
-				(--pointer)->~type();
-			}
+			type *pointer = &arrayPointer[index];
+			RelocateArrayElements(pointer + count, pointer, elementCount - index);
 
-			new (&arrayPointer[index]) type(static_cast<T&&>(element));
-			elementCount = count;
+			CopyArrayElements(pointer, elements, count);
+			elementCount = newCount;
 		}
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::RemoveArrayElement(int32 index)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::RemoveArrayElements(countType index, countType count)
 	{
 		if (index < elementCount)
 		{
-			type *pointer = &arrayPointer[index];
-			pointer->~type();
+			if (count > elementCount - index)
+			{
+				count = elementCount - index;
+			}
 
-			for (machine a = index + 1; a < elementCount; a++)
+			if (count > 0)
 			{
-				new(pointer) type(static_cast<type&&>(pointer[1]));
-				(++pointer)->~type();
+				type *pointer = &arrayPointer[index + count];
+				for (machine a = count - 1; a >= 0; a--)
+				{
+					(--pointer)->~type();
+				}
+
+				RelocateArrayElements(pointer, pointer + count, elementCount - index - count);
+				elementCount -= count;
 			}
+		}
+	}
 
-			elementCount--;
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, baseCount, allocatorType, countType, growthType, alignment>::RemoveArrayElementsUnordered(const countType *indexArray, countType count)
+	{
+		// The indexes are processed from last to first so that the element moved into
+		// each vacated location always comes from beyond all of the remaining indexes.
+
+		for (machine a = count - 1; a >= 0; a--)
+		{
+			RemoveArrayElementUnordered(indexArray[a]);
 		}
 	}
 
-	template <typename type, int32 baseCount>
-	void Array<type, baseCount>::RemoveLastArrayElement(void)
+	template <typename type, int32 baseCount, class allocatorType, typename countType, class growthType, int32 alignment>
+	template <typename predicateType>
+	countType Array<type, baseCount, allocatorType, countType, growthType, alignment>::RemoveArrayElementsIf(predicateType&& predicate)
 	{
-		int32 index = elementCount - 1;
-		if (index >= 0)
+		type *pointer = arrayPointer;
+		machine count = elementCount;
+
+		// Each run of elements that are kept is moved down in one step, so trivially
+		// relocatable elements are compacted with a single memmove per run.
+
+		machine newCount = 0;
+		machine a = 0;
+		while (a < count)
 		{
-			type *pointer = &arrayPointer[index];
-			pointer->~type();
+			machine start = a;
+			while ((a < count) && (!predicate(static_cast<const type&>(pointer[a]))))
+			{
+				a++;
+			}
 
-			elementCount = index;
+			if ((a != start) && (newCount != start))
+			{
+				RelocateArrayElements(pointer + newCount, pointer + start, a - start);
+			}
+
+			newCount += a - start;
+			if (a < count)
+			{
+				pointer[a].~type();
+				a++;
+			}
 		}
+
+		elementCount = countType(newCount);
+		return (countType(count - newCount));
 	}
 
 
-	template <typename type>
-	class Array<type, 0> final : public ImmutableArray<type>
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	class Array<type, 0, allocatorType, countType, growthType, alignment> final : private allocatorType, public ImmutableArray<type, countType>
 	{
 		private:
 
-			using ImmutableArray<type>::elementCount;
-			using ImmutableArray<type>::reservedCount;
-			using ImmutableArray<type>::arrayPointer;
+			using ImmutableArray<type, countType>::elementCount;
+			using ImmutableArray<type, countType>::reservedCount;
+			using ImmutableArray<type, countType>::arrayPointer;
+
+			typedef AlignedArrayStorage<allocatorType, ArrayAlignment<type, alignment>::value> storageType;
 
-			void SetReservedCount(int32 count);
+			void SetReservedCount(countType count);
 
 		public:
 
-			explicit Array(int32 count = 0);
+			explicit Array(countType count = 0);
+			Array(countType count, const allocatorType& allocator);
 			Array(const Array& array);
 			Array(Array&& array);
 			~Array();
 
+			Array& operator =(const Array& array);
+			Array& operator =(Array&& array);
+
+			allocatorType& GetArrayAllocator(void)
+			{
+				return (*this);
+			}
+
+			const allocatorType& GetArrayAllocator(void) const
+			{
+				return (*this);
+			}
+
+			countType GetArrayReservedCount(void) const
+			{
+				return (reservedCount);
+			}
+
+			umachine GetArrayReservedSize(void) const
+			{
+				return (sizeof(type) * reservedCount);
+			}
+
 			void ClearArray(void);
 			void PurgeArray(void);
-			void ReserveArrayElementCount(int32 count);
+			void ShrinkArray(void);
+			void SwapArray(Array& array);
+			void ReserveArrayElementCount(countType count);
 
-			void SetArrayElementCount(int32 count);
-			void SetArrayElementCount(int32 count, const type& init);
+			void SetArrayElementCount(countType count);
+			void SetArrayElementCount(countType count, const type& init);
 			type *AppendArrayElement(void);
 
 			template <typename T>
 			type *AppendArrayElement(T&& element);
 
 			template <typename T>
-			void InsertArrayElement(int32 index, T&& element);
+			void InsertArrayElement(countType index, T&& element);
+
+			template <typename... T>
+			type *EmplaceArrayElement(T&&... args);
 
-			void RemoveArrayElement(int32 index);
+			template <typename... T>
+			type *EmplaceArrayElementAt(countType index, T&&... args);
+
+			void RemoveArrayElement(countType index);
+			void RemoveArrayElementUnordered(countType index);
 			void RemoveLastArrayElement(void);
+
+			void AppendArrayElements(const type *elements, countType count);
+			void InsertArrayElements(countType index, const type *elements, countType count);
+			void RemoveArrayElements(countType index, countType count);
+			void RemoveArrayElementsUnordered(const countType *indexArray, countType count);
+
+			template <typename predicateType>
+			countType RemoveArrayElementsIf(predicateType&& predicate);
 	};
 
 
-	template <typename type>
-	Array<type, 0>::Array(int32 count)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, 0, allocatorType, countType, growthType, alignment>::Array(countType count)
 	{
 		elementCount = 0;
 		reservedCount = count;
 
-		arrayPointer = (count > 0) ? reinterpret_cast<type *>(new char[sizeof(type) * count]) : nullptr;
+		arrayPointer = (count > 0) ? static_cast<type *>(storageType::AllocateArrayStorage(this, sizeof(type) * count)) : nullptr;
 	}
 
-	template <typename type>
-	Array<type, 0>::Array(const Array& array)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, 0, allocatorType, countType, growthType, alignment>::Array(countType count, const allocatorType& allocator) : allocatorType(allocator)
+	{
+		elementCount = 0;
+		reservedCount = count;
+
+		arrayPointer = (count > 0) ? static_cast<type *>(storageType::AllocateArrayStorage(this, sizeof(type) * count)) : nullptr;
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, 0, allocatorType, countType, growthType, alignment>::Array(const Array& array) : allocatorType(array), ImmutableArray<type, countType>()
 	{
 		elementCount = array.elementCount;
 		reservedCount = array.reservedCount;
 
 		if (reservedCount > 0)
 		{
-			arrayPointer = reinterpret_cast<type *>(new char[sizeof(type) * reservedCount]);
+			arrayPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, sizeof(type) * reservedCount));
 			for (machine a = 0; a < elementCount; a++)
 			{
 				new(&arrayPointer[a]) type(array.arrayPointer[a]);
@@ -732,8 +2278,8 @@ namespace Terathon
 		}
 	}
 
-	template <typename type>
-	Array<type, 0>::Array(Array&& array)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, 0, allocatorType, countType, growthType, alignment>::Array(Array&& array) : allocatorType(static_cast<allocatorType&&>(array))
 	{
 		elementCount = array.elementCount;
 		reservedCount = array.reservedCount;
@@ -744,8 +2290,8 @@ namespace Terathon
 		array.arrayPointer = nullptr;
 	}
 
-	template <typename type>
-	Array<type, 0>::~Array()
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, 0, allocatorType, countType, growthType, alignment>::~Array()
 	{
 		type *pointer = arrayPointer + elementCount;
 		for (machine a = elementCount - 1; a >= 0; a--)
@@ -753,11 +2299,57 @@ namespace Terathon
 			(--pointer)->~type();
 		}
 
-		delete[] reinterpret_cast<char *>(arrayPointer);
+		if (arrayPointer)
+		{
+			storageType::ReleaseArrayStorage(this, arrayPointer, sizeof(type) * reservedCount);
+		}
 	}
 
-	template <typename type>
-	void Array<type, 0>::ClearArray(void)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, 0, allocatorType, countType, growthType, alignment>& Array<type, 0, allocatorType, countType, growthType, alignment>::operator =(const Array& array)
+	{
+		if (this != &array)
+		{
+			ClearArray();
+
+			countType count = array.elementCount;
+			if (count > 0)
+			{
+				if (count > reservedCount)
+				{
+					SetReservedCount(count);
+				}
+
+				CopyArrayElements(arrayPointer, array.arrayPointer, count);
+				elementCount = count;
+			}
+		}
+
+		return (*this);
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	Array<type, 0, allocatorType, countType, growthType, alignment>& Array<type, 0, allocatorType, countType, growthType, alignment>::operator =(Array&& array)
+	{
+		if (this != &array)
+		{
+			PurgeArray();
+			allocatorType::operator =(static_cast<allocatorType&&>(array));
+
+			elementCount = array.elementCount;
+			reservedCount = array.reservedCount;
+			arrayPointer = array.arrayPointer;
+
+			array.elementCount = 0;
+			array.reservedCount = 0;
+			array.arrayPointer = nullptr;
+		}
+
+		return (*this);
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::ClearArray(void)
 	{
 		type *pointer = arrayPointer + elementCount;
 		for (machine a = elementCount - 1; a >= 0; a--)
@@ -768,8 +2360,8 @@ namespace Terathon
 		elementCount = 0;
 	}
 
-	template <typename type>
-	void Array<type, 0>::PurgeArray(void)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::PurgeArray(void)
 	{
 		type *pointer = arrayPointer + elementCount;
 		for (machine a = elementCount - 1; a >= 0; a--)
@@ -777,37 +2369,115 @@ namespace Terathon
 			(--pointer)->~type();
 		}
 
-		delete[] reinterpret_cast<char *>(arrayPointer);
+		if (arrayPointer)
+		{
+			storageType::ReleaseArrayStorage(this, arrayPointer, sizeof(type) * reservedCount);
+		}
 
 		elementCount = 0;
 		reservedCount = 0;
 		arrayPointer = nullptr;
 	}
 
-	template <typename type>
-	void Array<type, 0>::SetReservedCount(int32 count)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::ShrinkArray(void)
+	{
+		if (elementCount == reservedCount)
+		{
+			return;
+		}
+
+		umachine size = sizeof(type) * reservedCount;
+		if (elementCount == 0)
+		{
+			storageType::ReleaseArrayStorage(this, arrayPointer, size);
+
+			reservedCount = 0;
+			arrayPointer = nullptr;
+			return;
+		}
+
+		umachine newSize = sizeof(type) * elementCount;
+		if (TriviallyRelocatable<type>::value)
+		{
+			void *storage = storageType::ReallocateArrayStorage(this, arrayPointer, size, newSize);
+			if (storage)
+			{
+				arrayPointer = static_cast<type *>(storage);
+				reservedCount = elementCount;
+				return;
+			}
+		}
+
+		type *newPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, newSize));
+		RelocateArrayElements(newPointer, arrayPointer, elementCount);
+		storageType::ReleaseArrayStorage(this, arrayPointer, size);
+
+		reservedCount = elementCount;
+		arrayPointer = newPointer;
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::SwapArray(Array& array)
 	{
-		reservedCount = Max(Max(count, 4), reservedCount + Max((reservedCount / 2 + 3) & ~3, 4));
-		type *newPointer = reinterpret_cast<type *>(new char[sizeof(type) * reservedCount]);
+		allocatorType allocator(static_cast<allocatorType&&>(*this));
+		allocatorType::operator =(static_cast<allocatorType&&>(array));
+		static_cast<allocatorType&>(array) = static_cast<allocatorType&&>(allocator);
+
+		countType count = elementCount;
+		elementCount = array.elementCount;
+		array.elementCount = count;
+
+		count = reservedCount;
+		reservedCount = array.reservedCount;
+		array.reservedCount = count;
 
 		type *pointer = arrayPointer;
-		if (pointer)
+		arrayPointer = array.arrayPointer;
+		array.arrayPointer = pointer;
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::SetReservedCount(countType count)
+	{
+		countType newReservedCount = CalculateArrayReservedCount<countType, growthType>(reservedCount, count, 4, sizeof(type));
+		umachine size = sizeof(type) * reservedCount;
+		umachine newSize = sizeof(type) * newReservedCount;
+
+		if (arrayPointer)
 		{
-			for (machine a = 0; a < elementCount; a++)
+			if (storageType::ExtendArrayStorage(this, arrayPointer, size, newSize))
+			{
+				reservedCount = newReservedCount;
+				return;
+			}
+
+			if (TriviallyRelocatable<type>::value)
 			{
-				new(&newPointer[a]) type(static_cast<type&&>(*pointer));
-				pointer->~type();
-				pointer++;
+				void *storage = storageType::ReallocateArrayStorage(this, arrayPointer, size, newSize);
+				if (storage)
+				{
+					arrayPointer = static_cast<type *>(storage);
+					reservedCount = newReservedCount;
+					return;
+				}
 			}
+		}
 
-			delete[] reinterpret_cast<char *>(arrayPointer);
+		type *newPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, newSize));
+
+		if (arrayPointer)
+		{
+			RelocateArrayElements(newPointer, arrayPointer, elementCount);
+			storageType::ReleaseArrayStorage(this, arrayPointer, size);
 		}
 
+		reservedCount = newReservedCount;
 		arrayPointer = newPointer;
 	}
 
-	template <typename type>
-	void Array<type, 0>::ReserveArrayElementCount(int32 count)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::ReserveArrayElementCount(countType count)
 	{
 		if (count > reservedCount)
 		{
@@ -815,8 +2485,8 @@ namespace Terathon
 		}
 	}
 
-	template <typename type>
-	void Array<type, 0>::SetArrayElementCount(int32 count)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::SetArrayElementCount(countType count)
 	{
 		if (count > reservedCount)
 		{
@@ -843,8 +2513,8 @@ namespace Terathon
 		elementCount = count;
 	}
 
-	template <typename type>
-	void Array<type, 0>::SetArrayElementCount(int32 count, const type& init)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::SetArrayElementCount(countType count, const type& init)
 	{
 		if (count > reservedCount)
 		{
@@ -871,8 +2541,8 @@ namespace Terathon
 		elementCount = count;
 	}
 
-	template <typename type>
-	type *Array<type, 0>::AppendArrayElement(void)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	type *Array<type, 0, allocatorType, countType, growthType, alignment>::AppendArrayElement(void)
 	{
 		if (elementCount >= reservedCount)
 		{
@@ -886,9 +2556,9 @@ namespace Terathon
 		return (pointer);
 	}
 
-	template <typename type>
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
 	template <typename T>
-	type *Array<type, 0>::AppendArrayElement(T&& element)
+	type *Array<type, 0, allocatorType, countType, growthType, alignment>::AppendArrayElement(T&& element)
 	{
 		if (elementCount >= reservedCount)
 		{
@@ -902,13 +2572,13 @@ namespace Terathon
 		return (pointer);
 	}
 
-	template <typename type>
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
 	template <typename T>
-	void Array<type, 0>::InsertArrayElement(int32 index, T&& element)
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::InsertArrayElement(countType index, T&& element)
 	{
 		if (index >= elementCount)
 		{
-			int32 count = index + 1;
+			countType count = index + 1;
 			if (count > reservedCount)
 			{
 				SetReservedCount(count);
@@ -925,46 +2595,108 @@ namespace Terathon
 		}
 		else
 		{
-			int32 count = elementCount + 1;
+			countType count = elementCount + 1;
+			if (count > reservedCount)
+			{
+				SetReservedCount(count);
+			}
+
+			type *pointer = &arrayPointer[index];
+			RelocateArrayElements(pointer + 1, pointer, elementCount - index);
+
+			new (pointer) type(static_cast<T&&>(element));
+			elementCount = count;
+		}
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	template <typename... T>
+	type *Array<type, 0, allocatorType, countType, growthType, alignment>::EmplaceArrayElement(T&&... args)
+	{
+		if (elementCount >= reservedCount)
+		{
+			SetReservedCount(elementCount + 1);
+		}
+
+		type *pointer = arrayPointer + elementCount;
+		new(pointer) type(static_cast<T&&>(args)...);
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	template <typename... T>
+	type *Array<type, 0, allocatorType, countType, growthType, alignment>::EmplaceArrayElementAt(countType index, T&&... args)
+	{
+		if (index >= elementCount)
+		{
+			countType count = index + 1;
 			if (count > reservedCount)
 			{
 				SetReservedCount(count);
 			}
 
-			type *pointer = &arrayPointer[elementCount];
-			for (machine a = elementCount; a > index; a--)
+			type *pointer = &arrayPointer[elementCount - 1];
+			for (machine a = elementCount; a < index; a++)
 			{
-				new(pointer) type(static_cast<type&&>(pointer[-1]));
-				(--pointer)->~type();
+				new(++pointer) type;
 			}
 
-			new (&arrayPointer[index]) type(static_cast<T&&>(element));
+			new(++pointer) type(static_cast<T&&>(args)...);
 			elementCount = count;
+			return (pointer);
+		}
+
+		countType count = elementCount + 1;
+		if (count > reservedCount)
+		{
+			SetReservedCount(count);
+		}
+
+		type *pointer = &arrayPointer[index];
+		RelocateArrayElements(pointer + 1, pointer, elementCount - index);
+
+		new(pointer) type(static_cast<T&&>(args)...);
+		elementCount = count;
+		return (pointer);
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::RemoveArrayElement(countType index)
+	{
+		if (index < elementCount)
+		{
+			type *pointer = &arrayPointer[index];
+			pointer->~type();
+
+			RelocateArrayElements(pointer, pointer + 1, elementCount - index - 1);
+			elementCount--;
 		}
 	}
 
-	template <typename type>
-	void Array<type, 0>::RemoveArrayElement(int32 index)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::RemoveArrayElementUnordered(countType index)
 	{
 		if (index < elementCount)
 		{
 			type *pointer = &arrayPointer[index];
 			pointer->~type();
 
-			for (machine a = index + 1; a < elementCount; a++)
+			countType last = elementCount - 1;
+			if (index != last)
 			{
-				new(pointer) type(static_cast<type&&>(pointer[1]));
-				(++pointer)->~type();
+				RelocateArrayElements(pointer, &arrayPointer[last], 1);
 			}
 
-			elementCount--;
+			elementCount = last;
 		}
 	}
 
-	template <typename type>
-	void Array<type, 0>::RemoveLastArrayElement(void)
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::RemoveLastArrayElement(void)
 	{
-		int32 index = elementCount - 1;
+		countType index = elementCount - 1;
 		if (index >= 0)
 		{
 			type *pointer = &arrayPointer[index];
@@ -973,6 +2705,135 @@ namespace Terathon
 			elementCount = index;
 		}
 	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::AppendArrayElements(const type *elements, countType count)
+	{
+		countType newCount = elementCount + count;
+		if (newCount > reservedCount)
+		{
+			SetReservedCount(newCount);
+		}
+
+		CopyArrayElements(arrayPointer + elementCount, elements, count);
+		elementCount = newCount;
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::InsertArrayElements(countType index, const type *elements, countType count)
+	{
+		if (index >= elementCount)
+		{
+			countType newCount = index + count;
+			if (newCount > reservedCount)
+			{
+				SetReservedCount(newCount);
+			}
+
+			type *pointer = &arrayPointer[elementCount - 1];
+			for (machine a = elementCount; a < index; a++)
+			{
+				new(++pointer) type;
+			}
+
+			CopyArrayElements(pointer + 1, elements, count);
+			elementCount = newCount;
+		}
+		else if (count > 0)
+		{
+			countType newCount = elementCount + count;
+			if (newCount > reservedCount)
+			{
+				SetReservedCount(newCount);
+			}
+
+			type *pointer = &arrayPointer[index];
+			RelocateArrayElements(pointer + count, pointer, elementCount - index);
+
+			CopyArrayElements(pointer, elements, count);
+			elementCount = newCount;
+		}
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::RemoveArrayElements(countType index, countType count)
+	{
+		if (index < elementCount)
+		{
+			if (count > elementCount - index)
+			{
+				count = elementCount - index;
+			}
+
+			if (count > 0)
+			{
+				type *pointer = &arrayPointer[index + count];
+				for (machine a = count - 1; a >= 0; a--)
+				{
+					(--pointer)->~type();
+				}
+
+				RelocateArrayElements(pointer, pointer + count, elementCount - index - count);
+				elementCount -= count;
+			}
+		}
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	void Array<type, 0, allocatorType, countType, growthType, alignment>::RemoveArrayElementsUnordered(const countType *indexArray, countType count)
+	{
+		// The indexes are processed from last to first so that the element moved into
+		// each vacated location always comes from beyond all of the remaining indexes.
+
+		for (machine a = count - 1; a >= 0; a--)
+		{
+			RemoveArrayElementUnordered(indexArray[a]);
+		}
+	}
+
+	template <typename type, class allocatorType, typename countType, class growthType, int32 alignment>
+	template <typename predicateType>
+	countType Array<type, 0, allocatorType, countType, growthType, alignment>::RemoveArrayElementsIf(predicateType&& predicate)
+	{
+		type *pointer = arrayPointer;
+		machine count = elementCount;
+
+		// Each run of elements that are kept is moved down in one step, so trivially
+		// relocatable elements are compacted with a single memmove per run.
+
+		machine newCount = 0;
+		machine a = 0;
+		while (a < count)
+		{
+			machine start = a;
+			while ((a < count) && (!predicate(static_cast<const type&>(pointer[a]))))
+			{
+				a++;
+			}
+
+			if ((a != start) && (newCount != start))
+			{
+				RelocateArrayElements(pointer + newCount, pointer + start, a - start);
+			}
+
+			newCount += a - start;
+			if (a < count)
+			{
+				pointer[a].~type();
+				a++;
+			}
+		}
+
+		elementCount = countType(newCount);
+		return (countType(count - newCount));
+	}
+
+
+	template <typename type, int32 baseCount = 0, class allocatorType = HeapArrayAllocator, class growthType = DefaultArrayGrowth>
+	using LargeArray = Array<type, baseCount, allocatorType, int64, growthType>;
+
+	template <typename type, int32 alignment, int32 baseCount = 0, class allocatorType = HeapArrayAllocator>
+	using AlignedArray = Array<type, baseCount, allocatorType, int32, DefaultArrayGrowth, alignment>;
 }
 
 
@@ -0,0 +1,144 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSAtomic_h
+#define TSAtomic_h
+
+
+#include "TSPlatform.h"
+
+
+#if defined(_MSC_VER)
+
+	extern "C"
+	{
+		long _InterlockedExchangeAdd(long volatile *, long);
+		#pragma intrinsic(_InterlockedExchangeAdd)
+
+		long _InterlockedExchange(long volatile *, long);
+		#pragma intrinsic(_InterlockedExchange)
+
+		long _InterlockedCompareExchange(long volatile *, long, long);
+		#pragma intrinsic(_InterlockedCompareExchange)
+
+		#if defined(_WIN64)
+
+			void *_InterlockedCompareExchangePointer(void *volatile *, void *, void *);
+			#pragma intrinsic(_InterlockedCompareExchangePointer)
+
+		#endif
+	}
+
+#endif
+
+
+namespace Terathon
+{
+	// All of the following functions are sequentially consistent. The add and
+	// compare-exchange functions return the value held before the operation.
+
+	inline int32 AtomicLoad(volatile int32 *ptr)
+	{
+		#if defined(_MSC_VER)
+
+			return (_InterlockedCompareExchange(reinterpret_cast<volatile long *>(ptr), 0, 0));
+
+		#else
+
+			return (__atomic_load_n(ptr, __ATOMIC_SEQ_CST));
+
+		#endif
+	}
+
+	inline void AtomicStore(volatile int32 *ptr, int32 value)
+	{
+		#if defined(_MSC_VER)
+
+			_InterlockedExchange(reinterpret_cast<volatile long *>(ptr), value);
+
+		#else
+
+			__atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+
+		#endif
+	}
+
+	inline int32 AtomicAdd(volatile int32 *ptr, int32 value)
+	{
+		#if defined(_MSC_VER)
+
+			return (_InterlockedExchangeAdd(reinterpret_cast<volatile long *>(ptr), value));
+
+		#else
+
+			return (__atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST));
+
+		#endif
+	}
+
+	inline int32 AtomicCompareExchange(volatile int32 *ptr, int32 expected, int32 desired)
+	{
+		#if defined(_MSC_VER)
+
+			return (_InterlockedCompareExchange(reinterpret_cast<volatile long *>(ptr), desired, expected));
+
+		#else
+
+			__atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			return (expected);
+
+		#endif
+	}
+
+	inline void *AtomicLoadPointer(void *volatile *ptr)
+	{
+		#if defined(_MSC_VER)
+
+			#if defined(_WIN64)
+
+				return (_InterlockedCompareExchangePointer(ptr, nullptr, nullptr));
+
+			#else
+
+				return (reinterpret_cast<void *>(_InterlockedCompareExchange(reinterpret_cast<volatile long *>(ptr), 0, 0)));
+
+			#endif
+
+		#else
+
+			return (__atomic_load_n(ptr, __ATOMIC_SEQ_CST));
+
+		#endif
+	}
+
+	inline void *AtomicCompareExchangePointer(void *volatile *ptr, void *expected, void *desired)
+	{
+		#if defined(_MSC_VER)
+
+			#if defined(_WIN64)
+
+				return (_InterlockedCompareExchangePointer(ptr, desired, expected));
+
+			#else
+
+				return (reinterpret_cast<void *>(_InterlockedCompareExchange(reinterpret_cast<volatile long *>(ptr), reinterpret_cast<long>(desired), reinterpret_cast<long>(expected))));
+
+			#endif
+
+		#else
+
+			__atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			return (expected);
+
+		#endif
+	}
+}
+
+
+#endif
@@ -20,6 +20,16 @@
 	{
 		unsigned char _BitScanReverse(unsigned long *, unsigned long);
 		#pragma intrinsic(_BitScanReverse)
+
+		unsigned char _BitScanForward(unsigned long *, unsigned long);
+		#pragma intrinsic(_BitScanForward)
+
+		#if defined(_M_X64) || defined(_M_ARM64)
+
+			unsigned char _BitScanForward64(unsigned long *, unsigned __int64);
+			#pragma intrinsic(_BitScanForward64)
+
+		#endif
 	}
 
 #endif
@@ -150,6 +160,76 @@ namespace Terathon
 	}
 
 
+	inline int32 Cnttz(uint32 n)
+	{
+		#if defined(_MSC_VER)
+
+			unsigned long	x;
+
+			if (_BitScanForward(&x, n) == 0)
+			{
+				return (32);
+			}
+
+			return (x);
+
+		#else
+
+			return ((n != 0) ? __builtin_ctz(n) : 32);
+
+		#endif
+	}
+
+	inline int32 Cnttz64(uint64 n)
+	{
+		#if defined(_MSC_VER)
+
+			#if defined(_M_X64) || defined(_M_ARM64)
+
+				unsigned long	x;
+
+				if (_BitScanForward64(&x, n) == 0)
+				{
+					return (64);
+				}
+
+				return (x);
+
+			#else
+
+				uint32 lo = uint32(n);
+				return ((lo != 0) ? Cnttz(lo) : Cnttz(uint32(n >> 32)) + 32);
+
+			#endif
+
+		#else
+
+			return ((n != 0) ? __builtin_ctzll(n) : 64);
+
+		#endif
+	}
+
+
+	inline int32 Popcnt64(uint64 n)
+	{
+		#if defined(_MSC_VER)
+
+			// The popcnt instruction is not available on every x86 processor that MSVC
+			// can target, so the bits are counted in parallel without it.
+
+			n = n - ((n >> 1) & 0x5555555555555555ULL);
+			n = (n & 0x3333333333333333ULL) + ((n >> 2) & 0x3333333333333333ULL);
+			n = (n + (n >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+			return (int32((n * 0x0101010101010101ULL) >> 56));
+
+		#else
+
+			return (__builtin_popcountll(n));
+
+		#endif
+	}
+
+
 	inline int32 IntLog2(uint32 n)
 	{
 		return (31 - Cntlz(n));
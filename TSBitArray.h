@@ -0,0 +1,931 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSBitArray_h
+#define TSBitArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_BITARRAY 1
+
+
+namespace Terathon
+{
+	struct BitWordAnd
+	{
+		static uint64 Combine(uint64 x, uint64 y)
+		{
+			return (x & y);
+		}
+
+		#if TERATHON_AVX2
+
+			static __m256i Combine(__m256i x, __m256i y)
+			{
+				return (_mm256_and_si256(x, y));
+			}
+
+		#elif TERATHON_SSE2
+
+			static __m128i Combine(__m128i x, __m128i y)
+			{
+				return (_mm_and_si128(x, y));
+			}
+
+		#elif TERATHON_NEON
+
+			static uint64x2_t Combine(uint64x2_t x, uint64x2_t y)
+			{
+				return (vandq_u64(x, y));
+			}
+
+		#endif
+	};
+
+	struct BitWordOr
+	{
+		static uint64 Combine(uint64 x, uint64 y)
+		{
+			return (x | y);
+		}
+
+		#if TERATHON_AVX2
+
+			static __m256i Combine(__m256i x, __m256i y)
+			{
+				return (_mm256_or_si256(x, y));
+			}
+
+		#elif TERATHON_SSE2
+
+			static __m128i Combine(__m128i x, __m128i y)
+			{
+				return (_mm_or_si128(x, y));
+			}
+
+		#elif TERATHON_NEON
+
+			static uint64x2_t Combine(uint64x2_t x, uint64x2_t y)
+			{
+				return (vorrq_u64(x, y));
+			}
+
+		#endif
+	};
+
+	struct BitWordXor
+	{
+		static uint64 Combine(uint64 x, uint64 y)
+		{
+			return (x ^ y);
+		}
+
+		#if TERATHON_AVX2
+
+			static __m256i Combine(__m256i x, __m256i y)
+			{
+				return (_mm256_xor_si256(x, y));
+			}
+
+		#elif TERATHON_SSE2
+
+			static __m128i Combine(__m128i x, __m128i y)
+			{
+				return (_mm_xor_si128(x, y));
+			}
+
+		#elif TERATHON_NEON
+
+			static uint64x2_t Combine(uint64x2_t x, uint64x2_t y)
+			{
+				return (veorq_u64(x, y));
+			}
+
+		#endif
+	};
+
+	struct BitWordAndNot
+	{
+		static uint64 Combine(uint64 x, uint64 y)
+		{
+			return (x & ~y);
+		}
+
+		#if TERATHON_AVX2
+
+			static __m256i Combine(__m256i x, __m256i y)
+			{
+				return (_mm256_andnot_si256(y, x));
+			}
+
+		#elif TERATHON_SSE2
+
+			static __m128i Combine(__m128i x, __m128i y)
+			{
+				return (_mm_andnot_si128(y, x));
+			}
+
+		#elif TERATHON_NEON
+
+			static uint64x2_t Combine(uint64x2_t x, uint64x2_t y)
+			{
+				return (vbicq_u64(x, y));
+			}
+
+		#endif
+	};
+
+
+	template <class operationType>
+	void CombineBitWords(uint64 *restrict dest, const uint64 *restrict source, machine count)
+	{
+		machine a = 0;
+
+		#if TERATHON_AVX2
+
+			for (; a + 4 <= count; a += 4)
+			{
+				__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dest + a));
+				__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + a));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + a), operationType::Combine(x, y));
+			}
+
+		#elif TERATHON_SSE2
+
+			for (; a + 2 <= count; a += 2)
+			{
+				__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + a));
+				__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + a));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + a), operationType::Combine(x, y));
+			}
+
+		#elif TERATHON_NEON
+
+			for (; a + 2 <= count; a += 2)
+			{
+				vst1q_u64(dest + a, operationType::Combine(vld1q_u64(dest + a), vld1q_u64(source + a)));
+			}
+
+		#endif
+
+		for (; a < count; a++)
+		{
+			dest[a] = operationType::Combine(dest[a], source[a]);
+		}
+	}
+
+	inline machine CountBitWords(const uint64 *words, machine count)
+	{
+		machine a = 0;
+		machine total = 0;
+
+		#if TERATHON_AVX2
+
+			// The bits in each byte are counted in parallel, and the byte counts are summed with
+			// the sad instruction, which produces one 64-bit total for every eight bytes.
+
+			const __m256i m1 = _mm256_set1_epi8(0x55);
+			const __m256i m2 = _mm256_set1_epi8(0x33);
+			const __m256i m4 = _mm256_set1_epi8(0x0F);
+
+			__m256i sum = _mm256_setzero_si256();
+			for (; a + 4 <= count; a += 4)
+			{
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + a));
+				v = _mm256_sub_epi8(v, _mm256_and_si256(_mm256_srli_epi64(v, 1), m1));
+				v = _mm256_add_epi8(_mm256_and_si256(v, m2), _mm256_and_si256(_mm256_srli_epi64(v, 2), m2));
+				v = _mm256_and_si256(_mm256_add_epi8(v, _mm256_srli_epi64(v, 4)), m4);
+				sum = _mm256_add_epi64(sum, _mm256_sad_epu8(v, _mm256_setzero_si256()));
+			}
+
+			alignas(32) uint64 lane[4];
+			_mm256_store_si256(reinterpret_cast<__m256i *>(lane), sum);
+			total = machine(lane[0] + lane[1] + lane[2] + lane[3]);
+
+		#elif TERATHON_SSE2
+
+			const __m128i m1 = _mm_set1_epi8(0x55);
+			const __m128i m2 = _mm_set1_epi8(0x33);
+			const __m128i m4 = _mm_set1_epi8(0x0F);
+
+			__m128i sum = _mm_setzero_si128();
+			for (; a + 2 <= count; a += 2)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + a));
+				v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+				v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+				v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+				sum = _mm_add_epi64(sum, _mm_sad_epu8(v, _mm_setzero_si128()));
+			}
+
+			alignas(16) uint64 lane[2];
+			_mm_store_si128(reinterpret_cast<__m128i *>(lane), sum);
+			total = machine(lane[0] + lane[1]);
+
+		#elif TERATHON_NEON
+
+			uint64x2_t sum = vdupq_n_u64(0);
+			for (; a + 2 <= count; a += 2)
+			{
+				uint8x16_t v = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(words + a)));
+				sum = vaddq_u64(sum, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(v))));
+			}
+
+			total = machine(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+
+		#endif
+
+		for (; a < count; a++)
+		{
+			total += Popcnt64(words[a]);
+		}
+
+		return (total);
+	}
+
+	inline machine FindBitWord(const uint64 *words, machine start, machine count, uint64 skip)
+	{
+		// Returns the index of the first word at or after start that is not equal to skip.
+
+		machine a = start;
+
+		#if TERATHON_AVX2
+
+			__m256i v = _mm256_set1_epi64x(int64(skip));
+			for (; a + 4 <= count; a += 4)
+			{
+				__m256i c = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + a)), v);
+				if (uint32(_mm256_movemask_epi8(c)) != 0xFFFFFFFFU)
+				{
+					break;
+				}
+			}
+
+		#elif TERATHON_SSE2
+
+			__m128i v = _mm_set1_epi64x(int64(skip));
+			for (; a + 2 <= count; a += 2)
+			{
+				__m128i c = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(words + a)), v);
+				if (_mm_movemask_epi8(c) != 0xFFFF)
+				{
+					break;
+				}
+			}
+
+		#elif TERATHON_NEON
+
+			uint64x2_t v = vdupq_n_u64(skip);
+			for (; a + 2 <= count; a += 2)
+			{
+				uint64x2_t c = veorq_u64(vld1q_u64(words + a), v);
+				if ((vgetq_lane_u64(c, 0) | vgetq_lane_u64(c, 1)) != 0)
+				{
+					break;
+				}
+			}
+
+		#endif
+
+		for (; a < count; a++)
+		{
+			if (words[a] != skip)
+			{
+				return (a);
+			}
+		}
+
+		return (-1);
+	}
+
+
+	class BitArrayIterator
+	{
+		private:
+
+			const uint64	*wordPointer;
+			uint64			wordBits;
+			machine			wordIndex;
+			machine			wordCount;
+
+			void FindNextWord(void)
+			{
+				while ((wordBits == 0) && (++wordIndex < wordCount))
+				{
+					wordBits = wordPointer[wordIndex];
+				}
+			}
+
+		public:
+
+			BitArrayIterator(const uint64 *pointer, machine count, machine index) : wordPointer(pointer), wordIndex(index), wordCount(count)
+			{
+				wordBits = 0;
+				if (index < count)
+				{
+					wordBits = pointer[index];
+					FindNextWord();
+				}
+			}
+
+			int32 operator *(void) const
+			{
+				return (int32((wordIndex << 6) + Cnttz64(wordBits)));
+			}
+
+			BitArrayIterator& operator ++(void)
+			{
+				wordBits &= wordBits - 1;
+				FindNextWord();
+				return (*this);
+			}
+
+			bool operator ==(const BitArrayIterator& iterator) const
+			{
+				return ((wordIndex == iterator.wordIndex) && (wordBits == iterator.wordBits));
+			}
+
+			bool operator !=(const BitArrayIterator& iterator) const
+			{
+				return ((wordIndex != iterator.wordIndex) || (wordBits != iterator.wordBits));
+			}
+	};
+
+
+	//# \class	BitArray		A container class that holds a packed array of boolean values.
+	//
+	//# The $BitArray$ class represents a dynamically resizable array of boolean values that are stored as single bits.
+	//
+	//# \def	template <int32 baseCount = 0, class allocatorType = HeapArrayAllocator, class growthType = DefaultArrayGrowth> class BitArray final
+	//
+	//# \tparam		baseCount		The number of bits for which storage space is built into the $BitArray$ object. This is rounded up to a multiple of 64.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the array when it grows beyond $baseCount$ bits.
+	//# \tparam		growthType		The policy that determines how much storage is reserved when the array grows. See $@Array@$.
+	//
+	//# \ctor	BitArray();
+	//# \ctor	explicit BitArray(const allocatorType& allocator);
+	//
+	//# \param	allocator	An allocator object that is copied into the array and used for all of its storage.
+	//
+	//# \desc
+	//# The $BitArray$ class template stores an array of boolean values using one bit per value, packed into 64-bit words.
+	//# It requires one eighth of the memory needed by an $Array<bool>$ object, and operations that affect many values at
+	//# once are carried out on entire words instead of individual bits. The words are stored in an $@Array@$ object, so a
+	//# bit array has the same inline storage and growth behavior, where the $baseCount$ and $growthType$ template parameters
+	//# have the same meanings that they have for the $@Array@$ class template.
+	//#
+	//# Bits beyond the size of the array in the last word are always zero. Whole ranges of bits can be set or cleared at
+	//# once, the number of set bits can be counted, and the first set or clear bit can be located. Another bit array can be
+	//# combined with a bit array using the logical operations AND, OR, XOR, and AND NOT. Where SSE2, AVX2, or Neon
+	//# instructions are available, these bulk operations process multiple words at a time.
+	//#
+	//# Iterating over a bit array with a range-based for loop produces the indexes of the bits that are set, in increasing
+	//# order. Words that contain no set bits are skipped, so the loop runs once for each set bit. This is illustrated by
+	//# the following code, where $array$ is a variable of type $BitArray<>$.
+	//
+	//# \source
+	//# for (int32 index : array)\n
+	//# {\n
+	//# \t...\n
+	//# }
+	//
+	//# \also	$@Array@$
+
+
+	//# \function	BitArray::GetArrayElementCount		Returns the current size of an array.
+	//
+	//# \proto	int32 GetArrayElementCount(void) const;
+	//
+	//# \desc
+	//# The $GetArrayElementCount$ function returns the number of bits currently stored in a bit array.
+	//
+	//# \also	$@BitArray::SetArrayElementCount@$
+
+
+	//# \function	BitArray::SetArrayElementCount		Sets the current size of an array.
+	//
+	//# \proto	void SetArrayElementCount(int32 count, bool value = false);
+	//
+	//# \param	count	The new size of the array.
+	//# \param	value	The value assigned to new bits when the array grows.
+	//
+	//# \desc
+	//# The $SetArrayElementCount$ function sets the number of bits in a bit array to $count$. If $count$ is greater than
+	//# the current size of the array, then the new bits are set to the value of the $value$ parameter.
+	//
+	//# \also	$@BitArray::GetArrayElementCount@$
+	//# \also	$@BitArray::AppendArrayElement@$
+
+
+	//# \function	BitArray::AppendArrayElement		Adds a bit to the end of an array.
+	//
+	//# \proto	void AppendArrayElement(bool value);
+	//
+	//# \param	value	The value of the new bit.
+	//
+	//# \desc
+	//# The $AppendArrayElement$ function increases the size of a bit array by one and sets the new bit to the value of
+	//# the $value$ parameter.
+	//
+	//# \also	$@BitArray::SetArrayElementCount@$
+
+
+	//# \function	BitArray::GetBit		Returns the value of a single bit.
+	//
+	//# \proto	bool GetBit(int32 index) const;
+	//
+	//# \param	index	The index of the bit. This must be less than the size of the array.
+	//
+	//# \desc
+	//# The $GetBit$ function returns the value of the bit at the position specified by the $index$ parameter.
+	//# The $[]$ operator can also be used to read a bit.
+	//
+	//# \also	$@BitArray::SetBit@$
+	//# \also	$@BitArray::ClearBit@$
+
+
+	//# \function	BitArray::SetBit		Sets a single bit.
+	//
+	//# \proto	void SetBit(int32 index);
+	//# \proto	void SetBit(int32 index, bool value);
+	//
+	//# \param	index	The index of the bit. This must be less than the size of the array.
+	//# \param	value	The new value of the bit.
+	//
+	//# \desc
+	//# The $SetBit$ function sets the bit at the position specified by the $index$ parameter to one, or to the value of
+	//# the $value$ parameter if it is specified.
+	//
+	//# \also	$@BitArray::ClearBit@$
+	//# \also	$@BitArray::ToggleBit@$
+	//# \also	$@BitArray::SetBitRange@$
+
+
+	//# \function	BitArray::ClearBit		Clears a single bit.
+	//
+	//# \proto	void ClearBit(int32 index);
+	//
+	//# \param	index	The index of the bit. This must be less than the size of the array.
+	//
+	//# \desc
+	//# The $ClearBit$ function sets the bit at the position specified by the $index$ parameter to zero.
+	//
+	//# \also	$@BitArray::SetBit@$
+	//# \also	$@BitArray::ClearBitRange@$
+
+
+	//# \function	BitArray::ToggleBit		Inverts a single bit.
+	//
+	//# \proto	void ToggleBit(int32 index);
+	//
+	//# \param	index	The index of the bit. This must be less than the size of the array.
+	//
+	//# \desc
+	//# The $ToggleBit$ function inverts the bit at the position specified by the $index$ parameter.
+	//
+	//# \also	$@BitArray::SetBit@$
+	//# \also	$@BitArray::ClearBit@$
+
+
+	//# \function	BitArray::SetBitRange		Sets a range of bits.
+	//
+	//# \proto	void SetBitRange(int32 start, int32 count);
+	//
+	//# \param	start	The index of the first bit to set.
+	//# \param	count	The number of bits to set. The range must lie within the array.
+	//
+	//# \desc
+	//# The $SetBitRange$ function sets $count$ consecutive bits to one beginning at the index specified by the $start$
+	//# parameter. Whole words inside the range are filled at once.
+	//
+	//# \also	$@BitArray::ClearBitRange@$
+	//# \also	$@BitArray::SetBit@$
+
+
+	//# \function	BitArray::ClearBitRange		Clears a range of bits.
+	//
+	//# \proto	void ClearBitRange(int32 start, int32 count);
+	//
+	//# \param	start	The index of the first bit to clear.
+	//# \param	count	The number of bits to clear. The range must lie within the array.
+	//
+	//# \desc
+	//# The $ClearBitRange$ function sets $count$ consecutive bits to zero beginning at the index specified by the $start$
+	//# parameter. Whole words inside the range are filled at once.
+	//
+	//# \also	$@BitArray::SetBitRange@$
+	//# \also	$@BitArray::ClearBit@$
+
+
+	//# \function	BitArray::CountSetBits		Returns the number of bits that are set.
+	//
+	//# \proto	int32 CountSetBits(void) const;
+	//
+	//# \desc
+	//# The $CountSetBits$ function returns the number of bits in a bit array that are set to one.
+	//
+	//# \also	$@BitArray::FindFirstSetBit@$
+
+
+	//# \function	BitArray::FindFirstSetBit		Returns the index of the first bit that is set.
+	//
+	//# \proto	int32 FindFirstSetBit(int32 start = 0) const;
+	//
+	//# \param	start	The index at which the search begins.
+	//
+	//# \desc
+	//# The $FindFirstSetBit$ function returns the smallest index greater than or equal to $start$ for which the bit in a
+	//# bit array is set to one. If there is no such bit, then the return value is &minus;1.
+	//
+	//# \also	$@BitArray::FindFirstClearBit@$
+	//# \also	$@BitArray::CountSetBits@$
+
+
+	//# \function	BitArray::FindFirstClearBit		Returns the index of the first bit that is clear.
+	//
+	//# \proto	int32 FindFirstClearBit(int32 start = 0) const;
+	//
+	//# \param	start	The index at which the search begins.
+	//
+	//# \desc
+	//# The $FindFirstClearBit$ function returns the smallest index greater than or equal to $start$ for which the bit in a
+	//# bit array is set to zero. If there is no such bit, then the return value is &minus;1.
+	//
+	//# \also	$@BitArray::FindFirstSetBit@$
+
+
+	//# \function	BitArray::AndBits		Performs a logical AND with another bit array.
+	//
+	//# \proto	template <int32 count, class A, class G> void AndBits(const BitArray<count, A, G>& array);
+	//
+	//# \param	array	The bit array to combine with this one.
+	//
+	//# \desc
+	//# The $AndBits$ function replaces each bit in a bit array with the logical AND of that bit and the corresponding bit in
+	//# the array specified by the $array$ parameter. The size of the array does not change, and if the other array is
+	//# smaller, then it is treated as if its missing bits were zero.
+	//
+	//# \also	$@BitArray::OrBits@$
+	//# \also	$@BitArray::XorBits@$
+	//# \also	$@BitArray::AndNotBits@$
+
+
+	//# \function	BitArray::OrBits		Performs a logical OR with another bit array.
+	//
+	//# \proto	template <int32 count, class A, class G> void OrBits(const BitArray<count, A, G>& array);
+	//
+	//# \param	array	The bit array to combine with this one.
+	//
+	//# \desc
+	//# The $OrBits$ function replaces each bit in a bit array with the logical OR of that bit and the corresponding bit in
+	//# the array specified by the $array$ parameter. The size of the array does not change, and bits in the other array
+	//# beyond the size of this array are ignored.
+	//
+	//# \also	$@BitArray::AndBits@$
+
+
+	//# \function	BitArray::XorBits		Performs a logical XOR with another bit array.
+	//
+	//# \proto	template <int32 count, class A, class G> void XorBits(const BitArray<count, A, G>& array);
+	//
+	//# \param	array	The bit array to combine with this one.
+	//
+	//# \desc
+	//# The $XorBits$ function replaces each bit in a bit array with the logical XOR of that bit and the corresponding bit in
+	//# the array specified by the $array$ parameter. The size of the array does not change, and bits in the other array
+	//# beyond the size of this array are ignored.
+	//
+	//# \also	$@BitArray::AndBits@$
+
+
+	//# \function	BitArray::AndNotBits		Clears the bits that are set in another bit array.
+	//
+	//# \proto	template <int32 count, class A, class G> void AndNotBits(const BitArray<count, A, G>& array);
+	//
+	//# \param	array	The bit array whose set bits are cleared in this one.
+	//
+	//# \desc
+	//# The $AndNotBits$ function replaces each bit in a bit array with the logical AND of that bit and the inverse of the
+	//# corresponding bit in the array specified by the $array$ parameter. The size of the array does not change, and bits
+	//# in the other array beyond the size of this array are ignored.
+	//
+	//# \also	$@BitArray::AndBits@$
+
+
+	template <int32 baseCount = 0, class allocatorType = HeapArrayAllocator, class growthType = DefaultArrayGrowth>
+	class BitArray final
+	{
+		private:
+
+			Array<uint64, ((baseCount + 63) >> 6), allocatorType, int32, growthType>		wordArray;
+			int32																		bitCount;
+
+			static machine GetWordCount(int32 count)
+			{
+				return ((machine(count) + 63) >> 6);
+			}
+
+			void ClearTailBits(void)
+			{
+				int32 tail = bitCount & 63;
+				if (tail != 0)
+				{
+					wordArray[bitCount >> 6] &= (uint64(1) << tail) - 1;
+				}
+			}
+
+			void FillBitRange(int32 start, int32 count, uint64 fill);
+
+			template <class operationType>
+			void CombineBits(const uint64 *words, machine wordCount)
+			{
+				CombineBitWords<operationType>(wordArray, words, Min64(GetWordCount(bitCount), wordCount));
+				ClearTailBits();
+			}
+
+		public:
+
+			BitArray()
+			{
+				bitCount = 0;
+			}
+
+			explicit BitArray(const allocatorType& allocator) : wordArray(allocator)
+			{
+				bitCount = 0;
+			}
+
+			bool operator [](machine index) const
+			{
+				return (GetBit(int32(index)));
+			}
+
+			BitArrayIterator begin(void) const
+			{
+				return (BitArrayIterator(wordArray, GetWordCount(bitCount), 0));
+			}
+
+			BitArrayIterator end(void) const
+			{
+				machine count = GetWordCount(bitCount);
+				return (BitArrayIterator(wordArray, count, count));
+			}
+
+			bool Empty(void) const
+			{
+				return (bitCount == 0);
+			}
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (bitCount);
+			}
+
+			int32 GetArrayReservedCount(void) const
+			{
+				return (int32(Min64(machine(wordArray.GetArrayReservedCount()) << 6, 0x7FFFFFFF)));
+			}
+
+			const uint64 *GetBitWords(void) const
+			{
+				return (wordArray);
+			}
+
+			machine GetBitWordCount(void) const
+			{
+				return (GetWordCount(bitCount));
+			}
+
+			bool GetBit(int32 index) const
+			{
+				return (((wordArray[index >> 6] >> (index & 63)) & 1) != 0);
+			}
+
+			void SetBit(int32 index)
+			{
+				wordArray[index >> 6] |= uint64(1) << (index & 63);
+			}
+
+			void SetBit(int32 index, bool value)
+			{
+				uint64 bit = uint64(1) << (index & 63);
+				uint64& word = wordArray[index >> 6];
+				word = (word & ~bit) | ((uint64(0) - uint64(value)) & bit);
+			}
+
+			void ClearBit(int32 index)
+			{
+				wordArray[index >> 6] &= ~(uint64(1) << (index & 63));
+			}
+
+			void ToggleBit(int32 index)
+			{
+				wordArray[index >> 6] ^= uint64(1) << (index & 63);
+			}
+
+			void SetBitRange(int32 start, int32 count)
+			{
+				FillBitRange(start, count, ~uint64(0));
+			}
+
+			void ClearBitRange(int32 start, int32 count)
+			{
+				FillBitRange(start, count, 0);
+			}
+
+			int32 CountSetBits(void) const
+			{
+				return (int32(CountBitWords(wordArray, GetWordCount(bitCount))));
+			}
+
+			int32 FindFirstSetBit(int32 start = 0) const;
+			int32 FindFirstClearBit(int32 start = 0) const;
+
+			template <int32 count, class A, class G>
+			void AndBits(const BitArray<count, A, G>& array);
+
+			template <int32 count, class A, class G>
+			void OrBits(const BitArray<count, A, G>& array)
+			{
+				CombineBits<BitWordOr>(array.GetBitWords(), array.GetBitWordCount());
+			}
+
+			template <int32 count, class A, class G>
+			void XorBits(const BitArray<count, A, G>& array)
+			{
+				CombineBits<BitWordXor>(array.GetBitWords(), array.GetBitWordCount());
+			}
+
+			template <int32 count, class A, class G>
+			void AndNotBits(const BitArray<count, A, G>& array)
+			{
+				CombineBits<BitWordAndNot>(array.GetBitWords(), array.GetBitWordCount());
+			}
+
+			void ClearArray(void)
+			{
+				wordArray.ClearArray();
+				bitCount = 0;
+			}
+
+			void PurgeArray(void)
+			{
+				wordArray.PurgeArray();
+				bitCount = 0;
+			}
+
+			void ReserveArrayElementCount(int32 count)
+			{
+				wordArray.ReserveArrayElementCount(int32(GetWordCount(count)));
+			}
+
+			void SetArrayElementCount(int32 count, bool value = false);
+			void AppendArrayElement(bool value);
+	};
+
+
+	template <int32 baseCount, class allocatorType, class growthType>
+	void BitArray<baseCount, allocatorType, growthType>::FillBitRange(int32 start, int32 count, uint64 fill)
+	{
+		if (count > 0)
+		{
+			uint64 *words = wordArray;
+			int32 finish = start + count - 1;
+			machine first = start >> 6;
+			machine last = finish >> 6;
+
+			uint64 firstMask = ~uint64(0) << (start & 63);
+			uint64 lastMask = ~uint64(0) >> (63 - (finish & 63));
+
+			if (first == last)
+			{
+				uint64 mask = firstMask & lastMask;
+				words[first] = (words[first] & ~mask) | (fill & mask);
+			}
+			else
+			{
+				words[first] = (words[first] & ~firstMask) | (fill & firstMask);
+				FillMemory(words + first + 1, sizeof(uint64) * (last - first - 1), uint8(fill));
+				words[last] = (words[last] & ~lastMask) | (fill & lastMask);
+			}
+		}
+	}
+
+	template <int32 baseCount, class allocatorType, class growthType>
+	int32 BitArray<baseCount, allocatorType, growthType>::FindFirstSetBit(int32 start) const
+	{
+		if (start < bitCount)
+		{
+			const uint64 *words = wordArray;
+			machine index = start >> 6;
+			uint64 bits = words[index] & (~uint64(0) << (start & 63));
+			if (bits == 0)
+			{
+				index = FindBitWord(words, index + 1, GetWordCount(bitCount), 0);
+				if (index < 0)
+				{
+					return (-1);
+				}
+
+				bits = words[index];
+			}
+
+			return (int32((index << 6) + Cnttz64(bits)));
+		}
+
+		return (-1);
+	}
+
+	template <int32 baseCount, class allocatorType, class growthType>
+	int32 BitArray<baseCount, allocatorType, growthType>::FindFirstClearBit(int32 start) const
+	{
+		if (start < bitCount)
+		{
+			const uint64 *words = wordArray;
+			machine index = start >> 6;
+			uint64 bits = ~words[index] & (~uint64(0) << (start & 63));
+			if (bits == 0)
+			{
+				index = FindBitWord(words, index + 1, GetWordCount(bitCount), ~uint64(0));
+				if (index < 0)
+				{
+					return (-1);
+				}
+
+				bits = ~words[index];
+			}
+
+			// The unused bits in the last word are zero, so they look like clear bits here.
+
+			int32 result = int32((index << 6) + Cnttz64(bits));
+			return ((result < bitCount) ? result : -1);
+		}
+
+		return (-1);
+	}
+
+	template <int32 baseCount, class allocatorType, class growthType>
+	template <int32 count, class A, class G>
+	void BitArray<baseCount, allocatorType, growthType>::AndBits(const BitArray<count, A, G>& array)
+	{
+		machine wordCount = GetWordCount(bitCount);
+		machine otherCount = array.GetBitWordCount();
+
+		CombineBitWords<BitWordAnd>(wordArray, array.GetBitWords(), Min64(wordCount, otherCount));
+		if (wordCount > otherCount)
+		{
+			FillMemory(static_cast<uint64 *>(wordArray) + otherCount, sizeof(uint64) * (wordCount - otherCount), 0);
+		}
+	}
+
+	template <int32 baseCount, class allocatorType, class growthType>
+	void BitArray<baseCount, allocatorType, growthType>::SetArrayElementCount(int32 count, bool value)
+	{
+		int32 oldCount = bitCount;
+		wordArray.SetArrayElementCount(int32(GetWordCount(count)), uint64(0));
+		bitCount = count;
+
+		if (count > oldCount)
+		{
+			if (value)
+			{
+				FillBitRange(oldCount, count - oldCount, ~uint64(0));
+			}
+		}
+		else
+		{
+			ClearTailBits();
+		}
+	}
+
+	template <int32 baseCount, class allocatorType, class growthType>
+	void BitArray<baseCount, allocatorType, growthType>::AppendArrayElement(bool value)
+	{
+		int32 index = bitCount;
+		if ((index & 63) == 0)
+		{
+			wordArray.AppendArrayElement(uint64(value));
+		}
+		else
+		{
+			wordArray[index >> 6] |= uint64(value) << (index & 63);
+		}
+
+		bitCount = index + 1;
+	}
+}
+
+
+#endif
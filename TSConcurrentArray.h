@@ -0,0 +1,380 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSConcurrentArray_h
+#define TSConcurrentArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+#include "TSAtomic.h"
+
+
+#define TERATHON_CONCURRENTARRAY 1
+
+
+namespace Terathon
+{
+	enum
+	{
+		kMaxConcurrentSegmentCount = 32
+	};
+
+
+	//# \class	ConcurrentArray		An array to which multiple threads can append elements simultaneously.
+	//
+	//# The $ConcurrentArray$ class represents an array that many threads can append to without locking.
+	//
+	//# \def	template <typename type, class allocatorType = HeapArrayAllocator> class ConcurrentArray final : public ImmutableArray<type, int32>
+	//
+	//# \tparam		type			The type of the class that can be stored in the array.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the array. It must be safe to call from multiple threads.
+	//
+	//# \ctor	explicit ConcurrentArray(int32 count = 1024);
+	//
+	//# \param	count	The number of elements that can be appended before a second segment is needed. This is rounded up to a power of two.
+	//
+	//# \desc
+	//# The $ConcurrentArray$ class template collects elements produced by multiple threads into a single array. The
+	//# $@ConcurrentArray::AppendArrayElement@$ and $@ConcurrentArray::AppendArrayElements@$ functions can be called by any
+	//# number of threads at the same time. Each call reserves space for its elements by atomically incrementing a counter,
+	//# and the elements are constructed in segments whose sizes double, so the elements never move while threads are still
+	//# appending to the array. When a segment needs to be allocated, the first thread to reach it installs it with an atomic
+	//# compare-exchange operation, and no thread ever waits for another.
+	//#
+	//# Once all threads have finished appending, the $@ConcurrentArray::SealArray@$ function is called by a single thread
+	//# to make the contents of the array available through its $@ImmutableArray@$ base class as a contiguous block of
+	//# memory. If all of the elements fit in the first segment, then sealing takes constant time. Otherwise, the elements
+	//# are moved into a new block of storage whose size is a power of two, and that block becomes the first segment when
+	//# the array is cleared. Consequently, an array that is filled to roughly the same size repeatedly needs to move its
+	//# elements only the first time it is sealed.
+	//#
+	//# The appending threads must be synchronized with the thread that seals the array, for example by waiting for
+	//# them to finish with the $@WorkerPool::ExecuteJobs@$ function. After an array has been sealed, no more elements may
+	//# be appended to it until the $@ConcurrentArray::ClearArray@$ or $@ConcurrentArray::PurgeArray@$ function is called.
+	//
+	//# \base	ImmutableArray<type, int32>		The contents of a sealed array are accessed through an immutable array.
+	//
+	//# \also	$@Array@$
+	//# \also	$@SegmentedArray@$
+
+
+	//# \function	ConcurrentArray::AppendArrayElement		Adds an object to the end of an array from any thread.
+	//
+	//# \proto	template <typename T> type *AppendArrayElement(T&& element);
+	//
+	//# \param	element		The new element to add to the array.
+	//
+	//# \desc
+	//# The $AppendArrayElement$ function reserves space for one element in a concurrent array and initializes it with the
+	//# value of the $element$ parameter. This function can be called by multiple threads simultaneously. Elements appended
+	//# by different threads are stored in the order in which their space was reserved, which is not generally predictable.
+	//# The return value is a pointer to the new element, and it remains valid until the array is sealed.
+	//
+	//# \also	$@ConcurrentArray::AppendArrayElements@$
+	//# \also	$@ConcurrentArray::SealArray@$
+
+
+	//# \function	ConcurrentArray::AppendArrayElements		Adds multiple objects to the end of an array from any thread.
+	//
+	//# \proto	void AppendArrayElements(const type *elements, int32 count);
+	//
+	//# \param	elements	A pointer to the elements to add to the array.
+	//# \param	count		The number of elements to add.
+	//
+	//# \desc
+	//# The $AppendArrayElements$ function reserves space for $count$ consecutive elements in a concurrent array with a single
+	//# atomic operation and copies the elements pointed to by the $elements$ parameter into it. This function can be called
+	//# by multiple threads simultaneously, and the elements appended by each call remain contiguous in the sealed array.
+	//# Threads producing many elements can reduce contention by collecting them locally and appending them in batches.
+	//
+	//# \also	$@ConcurrentArray::AppendArrayElement@$
+
+
+	//# \function	ConcurrentArray::SealArray		Makes the contents of an array accessible as a contiguous block.
+	//
+	//# \proto	void SealArray(void);
+	//
+	//# \desc
+	//# The $SealArray$ function finishes the appending phase of a concurrent array and makes all of its elements accessible
+	//# through the $@ImmutableArray@$ interface. This function must be called by a single thread after all threads that
+	//# appended elements to the array have finished doing so. If the elements occupy more than the first segment, then they
+	//# are moved into a single block of storage. Sealing an array that has already been sealed has no effect.
+	//
+	//# \also	$@ConcurrentArray::ClearArray@$
+
+
+	//# \function	ConcurrentArray::ClearArray		Removes all objects from an array.
+	//
+	//# \proto	void ClearArray(void);
+	//
+	//# \desc
+	//# The $ClearArray$ function destroys all of the elements in a concurrent array and prepares it for appending again.
+	//# The first segment is retained so that it can be reused. This function must not be called while other threads are
+	//# appending elements to the array.
+	//
+	//# \also	$@ConcurrentArray::PurgeArray@$
+
+
+	//# \function	ConcurrentArray::PurgeArray		Removes all objects from an array and deallocates storage.
+	//
+	//# \proto	void PurgeArray(void);
+	//
+	//# \desc
+	//# The $PurgeArray$ function destroys all of the elements in a concurrent array and releases all of its storage.
+	//# This function must not be called while other threads are appending elements to the array.
+	//
+	//# \also	$@ConcurrentArray::ClearArray@$
+
+
+	template <typename type, class allocatorType = HeapArrayAllocator>
+	class ConcurrentArray final : private allocatorType, public ImmutableArray<type, int32>
+	{
+		private:
+
+			using ImmutableArray<type, int32>::elementCount;
+			using ImmutableArray<type, int32>::reservedCount;
+			using ImmutableArray<type, int32>::arrayPointer;
+
+			typedef AlignedArrayStorage<allocatorType, ArrayAlignment<type, 0>::value> storageType;
+
+			volatile int32		appendCount;
+			int32				segmentShift;
+
+			void *volatile		segmentTable[kMaxConcurrentSegmentCount];
+
+			int64 GetSegmentStart(int32 segment) const
+			{
+				return ((int64(1) << (segment + segmentShift)) - (int64(1) << segmentShift));
+			}
+
+			int64 GetSegmentCapacity(int32 segment) const
+			{
+				// The last segment is cut short so that no index exceeds the range of int32.
+
+				return (Min64(int64(1) << (segment + segmentShift), int64(0x7FFFFFFF) - GetSegmentStart(segment)));
+			}
+
+			int32 GetSegmentIndex(int32 index) const
+			{
+				return (IntLog2((uint32(index) >> segmentShift) + 1));
+			}
+
+			type *GetSegment(int32 segment);
+			type *GetElementPointer(int32 index);
+			void ReleaseSegments(int32 firstSegment);
+
+			ConcurrentArray(const ConcurrentArray&) = delete;
+			ConcurrentArray& operator =(const ConcurrentArray&) = delete;
+
+		public:
+
+			explicit ConcurrentArray(int32 count = 1024);
+			ConcurrentArray(int32 count, const allocatorType& allocator);
+			~ConcurrentArray();
+
+			template <typename T>
+			type *AppendArrayElement(T&& element);
+
+			void AppendArrayElements(const type *elements, int32 count);
+
+			void SealArray(void);
+			void ClearArray(void);
+			void PurgeArray(void);
+	};
+
+
+	template <typename type, class allocatorType>
+	ConcurrentArray<type, allocatorType>::ConcurrentArray(int32 count)
+	{
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+
+		appendCount = 0;
+		segmentShift = IntLog2(Pow2Ceil(uint32(Max(count, 1))));
+
+		for (machine a = 0; a < kMaxConcurrentSegmentCount; a++)
+		{
+			segmentTable[a] = nullptr;
+		}
+	}
+
+	template <typename type, class allocatorType>
+	ConcurrentArray<type, allocatorType>::ConcurrentArray(int32 count, const allocatorType& allocator) : allocatorType(allocator)
+	{
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+
+		appendCount = 0;
+		segmentShift = IntLog2(Pow2Ceil(uint32(Max(count, 1))));
+
+		for (machine a = 0; a < kMaxConcurrentSegmentCount; a++)
+		{
+			segmentTable[a] = nullptr;
+		}
+	}
+
+	template <typename type, class allocatorType>
+	ConcurrentArray<type, allocatorType>::~ConcurrentArray()
+	{
+		PurgeArray();
+	}
+
+	template <typename type, class allocatorType>
+	type *ConcurrentArray<type, allocatorType>::GetSegment(int32 segment)
+	{
+		void *storage = AtomicLoadPointer(&segmentTable[segment]);
+		if (!storage)
+		{
+			// Several threads can reach a missing segment at the same time. Each of them allocates
+			// storage, but only the first one installs it, and the others release theirs.
+
+			umachine size = sizeof(type) * GetSegmentCapacity(segment);
+			void *newStorage = storageType::AllocateArrayStorage(this, size);
+			storage = AtomicCompareExchangePointer(&segmentTable[segment], nullptr, newStorage);
+			if (storage)
+			{
+				storageType::ReleaseArrayStorage(this, newStorage, size);
+			}
+			else
+			{
+				storage = newStorage;
+			}
+		}
+
+		return (static_cast<type *>(storage));
+	}
+
+	template <typename type, class allocatorType>
+	type *ConcurrentArray<type, allocatorType>::GetElementPointer(int32 index)
+	{
+		int32 segment = GetSegmentIndex(index);
+		return (GetSegment(segment) + machine(index - GetSegmentStart(segment)));
+	}
+
+	template <typename type, class allocatorType>
+	void ConcurrentArray<type, allocatorType>::ReleaseSegments(int32 firstSegment)
+	{
+		for (machine a = firstSegment; a < kMaxConcurrentSegmentCount; a++)
+		{
+			void *storage = segmentTable[a];
+			if (storage)
+			{
+				storageType::ReleaseArrayStorage(this, storage, sizeof(type) * GetSegmentCapacity(int32(a)));
+				segmentTable[a] = nullptr;
+			}
+		}
+	}
+
+	template <typename type, class allocatorType>
+	template <typename T>
+	type *ConcurrentArray<type, allocatorType>::AppendArrayElement(T&& element)
+	{
+		type *pointer = GetElementPointer(AtomicAdd(&appendCount, 1));
+		new(pointer) type(static_cast<T&&>(element));
+		return (pointer);
+	}
+
+	template <typename type, class allocatorType>
+	void ConcurrentArray<type, allocatorType>::AppendArrayElements(const type *elements, int32 count)
+	{
+		int32 index = AtomicAdd(&appendCount, count);
+		while (count > 0)
+		{
+			int32 segment = GetSegmentIndex(index);
+			int32 offset = int32(index - GetSegmentStart(segment));
+			int32 copyCount = int32(Min64(GetSegmentCapacity(segment) - offset, count));
+
+			CopyArrayElements(GetSegment(segment) + offset, elements, copyCount);
+
+			elements += copyCount;
+			index += copyCount;
+			count -= copyCount;
+		}
+	}
+
+	template <typename type, class allocatorType>
+	void ConcurrentArray<type, allocatorType>::SealArray(void)
+	{
+		int32 count = appendCount;
+		if ((arrayPointer) || (count == 0))
+		{
+			return;
+		}
+
+		if (count <= GetSegmentCapacity(0))
+		{
+			arrayPointer = static_cast<type *>(segmentTable[0]);
+		}
+		else
+		{
+			// The elements are gathered into a block that is large enough to hold all of them as
+			// its first segment, and all of the old segments are released.
+
+			int32 shift = IntLog2(Pow2Ceil(uint32(count)));
+			type *pointer = static_cast<type *>(storageType::AllocateArrayStorage(this, sizeof(type) * Min64(int64(1) << shift, 0x7FFFFFFF)));
+
+			int32 remaining = count;
+			for (machine a = 0; remaining > 0; a++)
+			{
+				int32 segmentCount = int32(Min64(GetSegmentCapacity(int32(a)), remaining));
+				RelocateArrayElements(pointer + GetSegmentStart(int32(a)), static_cast<type *>(segmentTable[a]), segmentCount);
+				remaining -= segmentCount;
+			}
+
+			ReleaseSegments(0);
+
+			segmentShift = shift;
+			segmentTable[0] = pointer;
+			arrayPointer = pointer;
+		}
+
+		elementCount = count;
+		reservedCount = count;
+	}
+
+	template <typename type, class allocatorType>
+	void ConcurrentArray<type, allocatorType>::ClearArray(void)
+	{
+		int32 remaining = appendCount;
+		for (machine a = 0; remaining > 0; a++)
+		{
+			type *pointer = static_cast<type *>(segmentTable[a]);
+			int32 segmentCount = int32(Min64(GetSegmentCapacity(int32(a)), remaining));
+			for (machine b = 0; b < segmentCount; b++)
+			{
+				pointer[b].~type();
+			}
+
+			remaining -= segmentCount;
+		}
+
+		ReleaseSegments(1);
+
+		appendCount = 0;
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+	}
+
+	template <typename type, class allocatorType>
+	void ConcurrentArray<type, allocatorType>::PurgeArray(void)
+	{
+		ClearArray();
+		ReleaseSegments(0);
+	}
+}
+
+
+#endif
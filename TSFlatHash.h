@@ -0,0 +1,828 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSFlatHash_h
+#define TSFlatHash_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_FLATHASHTABLE 1
+
+
+namespace Terathon
+{
+	enum : int8
+	{
+		kFlatHashControlEmpty		= -128,
+		kFlatHashControlDeleted		= -2
+	};
+
+
+	enum
+	{
+		kFlatHashGroupSize			= 16,
+		kFlatHashGroupShift			= 4,
+		kFlatHashMinCapacity		= 16
+	};
+
+
+	//# \class	FlatHashFunction		The default hash function used by a flat hash table.
+	//
+	//# The $FlatHashFunction$ class template calculates the hash values for the keys of a $@FlatHashTable@$ object.
+	//
+	//# \def	template <typename keyType> struct FlatHashFunction
+	//
+	//# \tparam		keyType		The type of the keys stored in the hash table.
+	//
+	//# \desc
+	//# The $FlatHashFunction$ class template contains a single static function named $Hash$ that takes a key and returns
+	//# a 32-bit hash value. It is specialized for 32-bit and 64-bit integers and for pointers, and for any other type,
+	//# it calls a static function of $keyType$ having one of the following two prototypes, which is the same function
+	//# used by the $@HashTable@$ class.
+	//
+	//# \source
+	//# static uint32 Hash(KeyType key);\n
+	//# static uint32 Hash(const KeyType& key);
+	//
+	//# \desc
+	//# The hash table scrambles the returned value before using it, so the hash function does not need to distribute its
+	//# values uniformly. However, distinct keys should produce distinct hash values as often as possible.
+	//
+	//# \also	$@FlatHashTable@$
+
+
+	template <typename keyType>
+	struct FlatHashFunction
+	{
+		static uint32 Hash(const keyType& key)
+		{
+			return (keyType::Hash(key));
+		}
+	};
+
+	template <>
+	struct FlatHashFunction<int32>
+	{
+		static uint32 Hash(int32 key)
+		{
+			return (uint32(key));
+		}
+	};
+
+	template <>
+	struct FlatHashFunction<uint32>
+	{
+		static uint32 Hash(uint32 key)
+		{
+			return (key);
+		}
+	};
+
+	template <>
+	struct FlatHashFunction<int64>
+	{
+		static uint32 Hash(int64 key)
+		{
+			return (uint32(key) ^ uint32(uint64(key) >> 32));
+		}
+	};
+
+	template <>
+	struct FlatHashFunction<uint64>
+	{
+		static uint32 Hash(uint64 key)
+		{
+			return (uint32(key) ^ uint32(key >> 32));
+		}
+	};
+
+	template <typename type>
+	struct FlatHashFunction<type *>
+	{
+		static uint32 Hash(type *key)
+		{
+			uint64 address = uint64(reinterpret_cast<machine_address>(key));
+			return (uint32(address) ^ uint32(address >> 32));
+		}
+	};
+
+
+	class FlatHashGroup
+	{
+		// The functions in this class compare all 16 control bytes of a group at once and return a
+		// mask with one set bit for each matching byte. On NEON, the mask has four bits per byte,
+		// and only the highest of them is kept, so the byte index is the bit index divided by four.
+
+		public:
+
+			#if TERATHON_NEON
+
+				static const int32 kMaskShift = 2;
+
+			#else
+
+				static const int32 kMaskShift = 0;
+
+			#endif
+
+			static int32 GetMatchIndex(uint64 mask)
+			{
+				return (Cnttz64(mask) >> kMaskShift);
+			}
+
+			static uint64 MatchControl(const int8 *control, int8 value)
+			{
+				#if TERATHON_SSE2
+
+					__m128i x = _mm_load_si128(reinterpret_cast<const __m128i *>(control));
+					return (uint64(_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(value)))));
+
+				#elif TERATHON_NEON
+
+					uint8x16_t x = vceqq_s8(vld1q_s8(control), vdupq_n_s8(value));
+					return (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(x), 4)), 0) & 0x8888888888888888ULL);
+
+				#else
+
+					uint64 mask = 0;
+					for (machine a = 0; a < kFlatHashGroupSize; a++)
+					{
+						mask |= uint64(control[a] == value) << a;
+					}
+
+					return (mask);
+
+				#endif
+			}
+
+			static uint64 MatchEmpty(const int8 *control)
+			{
+				return (MatchControl(control, kFlatHashControlEmpty));
+			}
+
+			static uint64 MatchEmptyOrDeleted(const int8 *control)
+			{
+				#if TERATHON_SSE2
+
+					return (uint64(_mm_movemask_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(control)))));
+
+				#elif TERATHON_NEON
+
+					uint8x16_t x = vreinterpretq_u8_s8(vshrq_n_s8(vld1q_s8(control), 7));
+					return (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(x), 4)), 0) & 0x8888888888888888ULL);
+
+				#else
+
+					uint64 mask = 0;
+					for (machine a = 0; a < kFlatHashGroupSize; a++)
+					{
+						mask |= uint64(control[a] < 0) << a;
+					}
+
+					return (mask);
+
+				#endif
+			}
+	};
+
+
+	template <typename keyType, typename valueType>
+	struct FlatHashTableEntry
+	{
+		keyType		entryKey;
+		valueType	entryValue;
+
+		template <typename K, typename... T>
+		FlatHashTableEntry(K&& key, T&&... args) : entryKey(static_cast<K&&>(key)), entryValue(static_cast<T&&>(args)...) {}
+	};
+
+
+	template <typename entryType>
+	class FlatHashTableIterator
+	{
+		private:
+
+			const int8		*controlPointer;
+			entryType		*entryPointer;
+			machine			entryIndex;
+			machine			entryCount;
+
+			void SkipEmptyEntries(void)
+			{
+				while ((entryIndex < entryCount) && (controlPointer[entryIndex] < 0))
+				{
+					entryIndex++;
+				}
+			}
+
+		public:
+
+			FlatHashTableIterator(const int8 *control, entryType *entry, machine index, machine count) : controlPointer(control), entryPointer(entry), entryIndex(index), entryCount(count)
+			{
+				SkipEmptyEntries();
+			}
+
+			entryType& operator *(void) const
+			{
+				return (entryPointer[entryIndex]);
+			}
+
+			entryType *operator ->(void) const
+			{
+				return (&entryPointer[entryIndex]);
+			}
+
+			FlatHashTableIterator& operator ++(void)
+			{
+				entryIndex++;
+				SkipEmptyEntries();
+				return (*this);
+			}
+
+			bool operator ==(const FlatHashTableIterator& iterator) const
+			{
+				return (entryIndex == iterator.entryIndex);
+			}
+
+			bool operator !=(const FlatHashTableIterator& iterator) const
+			{
+				return (entryIndex != iterator.entryIndex);
+			}
+	};
+
+
+	//# \class	FlatHashTable		A container class that stores key-value pairs in an open-addressing hash table.
+	//
+	//# The $FlatHashTable$ class stores key-value pairs directly inside a single block of memory.
+	//
+	//# \def	template <typename keyType, typename valueType, class hashType = FlatHashFunction<keyType>, class allocatorType = HeapArrayAllocator> class FlatHashTable final
+	//
+	//# \tparam		keyType			The type of the keys stored in the hash table. Keys are compared with the $==$ operator.
+	//# \tparam		valueType		The type of the values associated with the keys.
+	//# \tparam		hashType		A class containing a static function named $Hash$ that calculates the hash value for a key.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the hash table.
+	//
+	//# \ctor	FlatHashTable();
+	//# \ctor	explicit FlatHashTable(const allocatorType& allocator);
+	//
+	//# \param	allocator	An allocator object that is copied into the hash table and used for all of its storage.
+	//
+	//# \desc
+	//# The $FlatHashTable$ class template is a non-intrusive companion to the $@HashTable@$ class that is intended for
+	//# small keys and values, such as integers and handles. Instead of linking objects into buckets, it stores each key
+	//# and its value in an entry inside one array, and collisions are resolved by probing other entries. Each entry
+	//# has a one-byte control value that is either empty, deleted, or the low seven bits of the hash value of its key.
+	//# The control bytes are examined 16 at a time with SSE2 or NEON instructions, so a lookup usually compares only one
+	//# key and touches only two cache lines.
+	//#
+	//# The number of entries is always a power of two, and the table grows when it would become more than 7/8 full.
+	//# When an entry is removed, it can be marked as empty instead of deleted if its group of 16 entries still contains
+	//# an empty entry, which is usually the case, so removals don't normally leave tombstones that slow down lookups.
+	//# Any remaining tombstones are discarded when the table is rebuilt.
+	//#
+	//# Adding or removing entries can move other entries, so pointers returned by the functions of the hash table are
+	//# invalidated whenever the table is modified. It is possible to iterate over the entries of a flat hash table using
+	//# a range-based for loop. The entries are of type $FlatHashTableEntry<keyType, valueType>$, which has members named
+	//# $entryKey$ and $entryValue$, and they are visited in no particular order.
+	//
+	//# \also	$@HashTable@$
+	//# \also	$@FlatHashFunction@$
+
+
+	//# \function	FlatHashTable::GetHashTableElementCount		Returns the number of elements in a hash table.
+	//
+	//# \proto	int32 GetHashTableElementCount(void) const;
+	//
+	//# \desc
+	//# The $GetHashTableElementCount$ function returns the number of key-value pairs stored in a flat hash table.
+
+
+	//# \function	FlatHashTable::FindHashTableElement		Finds the value associated with a key.
+	//
+	//# \proto	valueType *FindHashTableElement(const keyType& key) const;
+	//
+	//# \param	key		The key to find.
+	//
+	//# \desc
+	//# The $FindHashTableElement$ function searches a flat hash table for an entry whose key matches the $key$ parameter.
+	//# If one is found, then a pointer to its value is returned. Otherwise, the return value is $nullptr$.
+	//
+	//# \also	$@FlatHashTable::InsertHashTableElement@$
+
+
+	//# \function	FlatHashTable::InsertHashTableElement		Inserts a key-value pair into a hash table.
+	//
+	//# \proto	template <typename K, typename V> valueType *InsertHashTableElement(K&& key, V&& value);
+	//# \proto	template <typename K, typename... T> valueType *EmplaceHashTableElement(K&& key, T&&... args);
+	//
+	//# \param	key		The key to insert.
+	//# \param	value	The value associated with the key.
+	//# \param	args	The arguments passed to the constructor of the value.
+	//
+	//# \desc
+	//# The $InsertHashTableElement$ function associates the value specified by the $value$ parameter with the key specified
+	//# by the $key$ parameter. If the key is already in the hash table, then its value is replaced. Otherwise, a new entry
+	//# is added. The return value is a pointer to the value stored in the hash table.
+	//#
+	//# The $EmplaceHashTableElement$ function adds a new entry only if the key is not already in the hash table, and it
+	//# constructs the value in place using the arguments that follow the key. The return value is a pointer to the value
+	//# associated with the key, whether it was added or it already existed.
+	//
+	//# \also	$@FlatHashTable::FindHashTableElement@$
+	//# \also	$@FlatHashTable::RemoveHashTableElement@$
+
+
+	//# \function	FlatHashTable::RemoveHashTableElement		Removes a key from a hash table.
+	//
+	//# \proto	bool RemoveHashTableElement(const keyType& key);
+	//
+	//# \param	key		The key to remove.
+	//
+	//# \desc
+	//# The $RemoveHashTableElement$ function removes the entry whose key matches the $key$ parameter and destroys its key
+	//# and value. The return value is $true$ if an entry was removed, and it is $false$ if the key was not found.
+	//
+	//# \also	$@FlatHashTable::RemoveAllHashTableElements@$
+	//# \also	$@FlatHashTable::PurgeHashTable@$
+
+
+	//# \function	FlatHashTable::RemoveAllHashTableElements		Removes all elements from a hash table.
+	//
+	//# \proto	void RemoveAllHashTableElements(void);
+	//
+	//# \desc
+	//# The $RemoveAllHashTableElements$ function destroys all of the entries in a flat hash table. The storage allocated
+	//# by the hash table is retained.
+	//
+	//# \also	$@FlatHashTable::PurgeHashTable@$
+
+
+	//# \function	FlatHashTable::PurgeHashTable		Removes all elements from a hash table and deallocates its storage.
+	//
+	//# \proto	void PurgeHashTable(void);
+	//
+	//# \desc
+	//# The $PurgeHashTable$ function destroys all of the entries in a flat hash table and releases its storage.
+	//
+	//# \also	$@FlatHashTable::RemoveAllHashTableElements@$
+
+
+	//# \function	FlatHashTable::ReserveHashTableElementCount		Allocates storage for a specific number of elements.
+	//
+	//# \proto	void ReserveHashTableElementCount(int32 count);
+	//
+	//# \param	count	The number of elements for which storage is reserved.
+	//
+	//# \desc
+	//# The $ReserveHashTableElementCount$ function enlarges a flat hash table, if necessary, so that it can hold $count$
+	//# elements without growing again.
+
+
+	template <typename keyType, typename valueType, class hashType = FlatHashFunction<keyType>, class allocatorType = HeapArrayAllocator>
+	class FlatHashTable final : private allocatorType
+	{
+		public:
+
+			typedef FlatHashTableEntry<keyType, valueType>		entryType;
+
+		private:
+
+			static const umachine kStorageAlignment = (alignof(entryType) > umachine(kFlatHashGroupSize)) ? alignof(entryType) : umachine(kFlatHashGroupSize);
+			typedef AlignedArrayStorage<allocatorType, kStorageAlignment> storageType;
+
+			int32			elementCount;
+			int32			entryCount;
+			int32			growthLimit;
+
+			int8			*controlTable;
+			entryType		*entryTable;
+
+			static uint32 MixHash(uint32 hash)
+			{
+				hash ^= hash >> 16;
+				hash *= 0x85EBCA6BU;
+				hash ^= hash >> 13;
+				hash *= 0xC2B2AE35U;
+				return (hash ^ (hash >> 16));
+			}
+
+			static umachine GetControlSize(int32 count)
+			{
+				return ((umachine(count) + (kStorageAlignment - 1)) & ~(kStorageAlignment - 1));
+			}
+
+			static umachine GetStorageSize(int32 count)
+			{
+				return (GetControlSize(count) + umachine(count) * sizeof(entryType));
+			}
+
+			static int32 GetGrowthLimit(int32 count)
+			{
+				return (count - (count >> 3));
+			}
+
+			void AllocateTable(int32 count);
+			void ReleaseTable(void);
+			void RebuildTable(int32 count);
+
+			machine FindEntry(const keyType& key, uint32 hash) const;
+			machine FindInsertionEntry(uint32 hash) const;
+			machine PrepareInsertion(uint32 hash);
+
+			FlatHashTable& operator =(const FlatHashTable&) = delete;
+
+		public:
+
+			FlatHashTable();
+			explicit FlatHashTable(const allocatorType& allocator);
+			FlatHashTable(const FlatHashTable& table);
+			FlatHashTable(FlatHashTable&& table);
+			~FlatHashTable();
+
+			int32 GetHashTableElementCount(void) const
+			{
+				return (elementCount);
+			}
+
+			int32 GetHashTableEntryCount(void) const
+			{
+				return (entryCount);
+			}
+
+			bool Empty(void) const
+			{
+				return (elementCount == 0);
+			}
+
+			FlatHashTableIterator<entryType> begin(void) const
+			{
+				return (FlatHashTableIterator<entryType>(controlTable, entryTable, 0, entryCount));
+			}
+
+			FlatHashTableIterator<entryType> end(void) const
+			{
+				return (FlatHashTableIterator<entryType>(controlTable, entryTable, entryCount, entryCount));
+			}
+
+			valueType *FindHashTableElement(const keyType& key) const
+			{
+				machine index = FindEntry(key, MixHash(hashType::Hash(key)));
+				return ((index >= 0) ? &entryTable[index].entryValue : nullptr);
+			}
+
+			template <typename K, typename V>
+			valueType *InsertHashTableElement(K&& key, V&& value);
+
+			template <typename K, typename... T>
+			valueType *EmplaceHashTableElement(K&& key, T&&... args);
+
+			bool RemoveHashTableElement(const keyType& key);
+			void RemoveAllHashTableElements(void);
+			void PurgeHashTable(void);
+			void ReserveHashTableElementCount(int32 count);
+	};
+
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	FlatHashTable<keyType, valueType, hashType, allocatorType>::FlatHashTable()
+	{
+		elementCount = 0;
+		entryCount = 0;
+		growthLimit = 0;
+		controlTable = nullptr;
+		entryTable = nullptr;
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	FlatHashTable<keyType, valueType, hashType, allocatorType>::FlatHashTable(const allocatorType& allocator) : allocatorType(allocator)
+	{
+		elementCount = 0;
+		entryCount = 0;
+		growthLimit = 0;
+		controlTable = nullptr;
+		entryTable = nullptr;
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	FlatHashTable<keyType, valueType, hashType, allocatorType>::FlatHashTable(const FlatHashTable& table) : allocatorType(table)
+	{
+		elementCount = 0;
+		entryCount = 0;
+		growthLimit = 0;
+		controlTable = nullptr;
+		entryTable = nullptr;
+
+		int32 count = table.entryCount;
+		if (count != 0)
+		{
+			// The copy has the same size, so every entry is copied to the same location,
+			// and the control bytes (including any tombstones) are copied unchanged.
+
+			AllocateTable(count);
+			CopyMemory(table.controlTable, controlTable, count);
+
+			for (machine a = 0; a < count; a++)
+			{
+				if (controlTable[a] >= 0)
+				{
+					new(&entryTable[a]) entryType(static_cast<const entryType&>(table.entryTable[a]));
+				}
+			}
+
+			elementCount = table.elementCount;
+			growthLimit = table.growthLimit;
+		}
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	FlatHashTable<keyType, valueType, hashType, allocatorType>::FlatHashTable(FlatHashTable&& table) : allocatorType(static_cast<allocatorType&&>(table))
+	{
+		elementCount = table.elementCount;
+		entryCount = table.entryCount;
+		growthLimit = table.growthLimit;
+		controlTable = table.controlTable;
+		entryTable = table.entryTable;
+
+		table.elementCount = 0;
+		table.entryCount = 0;
+		table.growthLimit = 0;
+		table.controlTable = nullptr;
+		table.entryTable = nullptr;
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	FlatHashTable<keyType, valueType, hashType, allocatorType>::~FlatHashTable()
+	{
+		PurgeHashTable();
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	void FlatHashTable<keyType, valueType, hashType, allocatorType>::AllocateTable(int32 count)
+	{
+		char *storage = static_cast<char *>(storageType::AllocateArrayStorage(this, GetStorageSize(count)));
+		controlTable = reinterpret_cast<int8 *>(storage);
+		entryTable = reinterpret_cast<entryType *>(storage + GetControlSize(count));
+
+		FillMemory(controlTable, count, uint8(kFlatHashControlEmpty));
+		entryCount = count;
+		growthLimit = GetGrowthLimit(count);
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	void FlatHashTable<keyType, valueType, hashType, allocatorType>::ReleaseTable(void)
+	{
+		storageType::ReleaseArrayStorage(this, controlTable, GetStorageSize(entryCount));
+		controlTable = nullptr;
+		entryTable = nullptr;
+		entryCount = 0;
+		growthLimit = 0;
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	void FlatHashTable<keyType, valueType, hashType, allocatorType>::RebuildTable(int32 count)
+	{
+		// Every element is moved into a new table of the given size. Tombstones are not carried
+		// over, so rebuilding at the same size is how a table with many removals is cleaned up.
+
+		int8 *oldControl = controlTable;
+		entryType *oldEntry = entryTable;
+		int32 oldCount = entryCount;
+
+		AllocateTable(count);
+
+		for (machine a = 0; a < oldCount; a++)
+		{
+			if (oldControl[a] >= 0)
+			{
+				uint32 hash = MixHash(hashType::Hash(oldEntry[a].entryKey));
+				machine index = FindInsertionEntry(hash);
+
+				controlTable[index] = int8(hash & 0x7F);
+				RelocateArrayElements(&entryTable[index], &oldEntry[a], 1);
+			}
+		}
+
+		growthLimit -= elementCount;
+
+		if (oldCount != 0)
+		{
+			storageType::ReleaseArrayStorage(this, oldControl, GetStorageSize(oldCount));
+		}
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	machine FlatHashTable<keyType, valueType, hashType, allocatorType>::FindEntry(const keyType& key, uint32 hash) const
+	{
+		if (entryCount == 0)
+		{
+			return (-1);
+		}
+
+		// The groups are probed in triangular order, which visits every group exactly once
+		// because the number of groups is a power of two. The search can stop at the first
+		// group containing an empty entry because an insertion would have used that entry.
+
+		int8 control = int8(hash & 0x7F);
+		machine groupMask = (entryCount >> kFlatHashGroupShift) - 1;
+		machine group = (hash >> 7) & groupMask;
+
+		for (machine step = 1;; step++)
+		{
+			const int8 *groupControl = controlTable + (group << kFlatHashGroupShift);
+
+			uint64 mask = FlatHashGroup::MatchControl(groupControl, control);
+			while (mask != 0)
+			{
+				machine index = (group << kFlatHashGroupShift) + FlatHashGroup::GetMatchIndex(mask);
+				if (entryTable[index].entryKey == key)
+				{
+					return (index);
+				}
+
+				mask &= mask - 1;
+			}
+
+			if (FlatHashGroup::MatchEmpty(groupControl) != 0)
+			{
+				return (-1);
+			}
+
+			group = (group + step) & groupMask;
+		}
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	machine FlatHashTable<keyType, valueType, hashType, allocatorType>::FindInsertionEntry(uint32 hash) const
+	{
+		machine groupMask = (entryCount >> kFlatHashGroupShift) - 1;
+		machine group = (hash >> 7) & groupMask;
+
+		for (machine step = 1;; step++)
+		{
+			uint64 mask = FlatHashGroup::MatchEmptyOrDeleted(controlTable + (group << kFlatHashGroupShift));
+			if (mask != 0)
+			{
+				return ((group << kFlatHashGroupShift) + FlatHashGroup::GetMatchIndex(mask));
+			}
+
+			group = (group + step) & groupMask;
+		}
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	machine FlatHashTable<keyType, valueType, hashType, allocatorType>::PrepareInsertion(uint32 hash)
+	{
+		// This is called only after the key is known to be missing. Reusing a tombstone doesn't
+		// consume any growth, but filling an empty entry does, and the table is rebuilt first if
+		// no growth remains. The table only doubles in size if it is actually more than half full.
+
+		machine index = (entryCount != 0) ? FindInsertionEntry(hash) : -1;
+		if ((index < 0) || ((growthLimit == 0) && (controlTable[index] == kFlatHashControlEmpty)))
+		{
+			int32 count = entryCount;
+			if (count == 0)
+			{
+				count = kFlatHashMinCapacity;
+			}
+			else if (elementCount >= (GetGrowthLimit(count) >> 1))
+			{
+				count <<= 1;
+			}
+
+			RebuildTable(count);
+			index = FindInsertionEntry(hash);
+		}
+
+		if (controlTable[index] == kFlatHashControlEmpty)
+		{
+			growthLimit--;
+		}
+
+		controlTable[index] = int8(hash & 0x7F);
+		elementCount++;
+		return (index);
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	template <typename K, typename V>
+	valueType *FlatHashTable<keyType, valueType, hashType, allocatorType>::InsertHashTableElement(K&& key, V&& value)
+	{
+		uint32 hash = MixHash(hashType::Hash(key));
+		machine index = FindEntry(key, hash);
+		if (index >= 0)
+		{
+			valueType *pointer = &entryTable[index].entryValue;
+			*pointer = static_cast<V&&>(value);
+			return (pointer);
+		}
+
+		index = PrepareInsertion(hash);
+		entryType *entry = new(&entryTable[index]) entryType(static_cast<K&&>(key), static_cast<V&&>(value));
+		return (&entry->entryValue);
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	template <typename K, typename... T>
+	valueType *FlatHashTable<keyType, valueType, hashType, allocatorType>::EmplaceHashTableElement(K&& key, T&&... args)
+	{
+		uint32 hash = MixHash(hashType::Hash(key));
+		machine index = FindEntry(key, hash);
+		if (index >= 0)
+		{
+			return (&entryTable[index].entryValue);
+		}
+
+		index = PrepareInsertion(hash);
+		entryType *entry = new(&entryTable[index]) entryType(static_cast<K&&>(key), static_cast<T&&>(args)...);
+		return (&entry->entryValue);
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	bool FlatHashTable<keyType, valueType, hashType, allocatorType>::RemoveHashTableElement(const keyType& key)
+	{
+		machine index = FindEntry(key, MixHash(hashType::Hash(key)));
+		if (index < 0)
+		{
+			return (false);
+		}
+
+		entryTable[index].~entryType();
+		elementCount--;
+
+		// If the group still has an empty entry, then it has never been full since the table was
+		// last rebuilt, so no probe sequence has passed through it, and the entry can be made empty.
+		// Otherwise, a tombstone is needed so that lookups continue to the following groups.
+
+		if (FlatHashGroup::MatchEmpty(controlTable + (index & ~machine(kFlatHashGroupSize - 1))) != 0)
+		{
+			controlTable[index] = kFlatHashControlEmpty;
+			growthLimit++;
+		}
+		else
+		{
+			controlTable[index] = kFlatHashControlDeleted;
+		}
+
+		return (true);
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	void FlatHashTable<keyType, valueType, hashType, allocatorType>::RemoveAllHashTableElements(void)
+	{
+		int32 count = entryCount;
+		if (count != 0)
+		{
+			for (machine a = 0; a < count; a++)
+			{
+				if (controlTable[a] >= 0)
+				{
+					entryTable[a].~entryType();
+				}
+			}
+
+			FillMemory(controlTable, count, uint8(kFlatHashControlEmpty));
+			elementCount = 0;
+			growthLimit = GetGrowthLimit(count);
+		}
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	void FlatHashTable<keyType, valueType, hashType, allocatorType>::PurgeHashTable(void)
+	{
+		if (entryCount != 0)
+		{
+			RemoveAllHashTableElements();
+			ReleaseTable();
+		}
+	}
+
+	template <typename keyType, typename valueType, class hashType, class allocatorType>
+	void FlatHashTable<keyType, valueType, hashType, allocatorType>::ReserveHashTableElementCount(int32 count)
+	{
+		int32 newCount = kFlatHashMinCapacity;
+		while (GetGrowthLimit(newCount) < count)
+		{
+			newCount <<= 1;
+		}
+
+		if (newCount > entryCount)
+		{
+			RebuildTable(newCount);
+		}
+	}
+}
+
+
+#endif
@@ -33,6 +33,101 @@ HashTableBucket::~HashTableBucket()
 	PurgeBucket();
 }
 
+HashTableBucketLine *HashTableBucket::NewBucketLine(void)
+{
+	// Overflow lines are aligned to a cache line boundary by hand because operator new isn't
+	// required to honor the alignment of the type. The original pointer is stored just before
+	// the aligned line so that it can be freed later.
+
+	char *storage = new char[sizeof(HashTableBucketLine) + kHashTableLineSize];
+	char *aligned = reinterpret_cast<char *>((reinterpret_cast<machine_address>(storage) & ~machine_address(kHashTableLineSize - 1)) + kHashTableLineSize);
+	reinterpret_cast<char **>(aligned)[-1] = storage;
+
+	HashTableBucketLine *line = reinterpret_cast<HashTableBucketLine *>(aligned);
+	line->nextLine = nullptr;
+	line->lineEntryCount = 0;
+	return (line);
+}
+
+void HashTableBucket::DeleteBucketLine(HashTableBucketLine *line)
+{
+	delete[] reinterpret_cast<char **>(line)[-1];
+}
+
+void HashTableBucket::AddLineElement(HashTableElementBase *element)
+{
+	HashTableBucketLine *line = bucketLine;
+	while (line->nextLine)
+	{
+		line = line->nextLine;
+	}
+
+	machine count = line->lineEntryCount;
+	if (count == kHashTableLineEntryCount)
+	{
+		HashTableBucketLine *newLine = NewBucketLine();
+		line->nextLine = newLine;
+		line = newLine;
+		count = 0;
+	}
+
+	line->lineElement[count] = element;
+	line->lineFingerprint[count] = HashTableBucketLine::GetFingerprint(element->hashValue);
+	line->lineEntryCount = uint8(count + 1);
+}
+
+void HashTableBucket::RemoveLineElement(HashTableElementBase *element)
+{
+	uint8 fingerprint = HashTableBucketLine::GetFingerprint(element->hashValue);
+
+	HashTableBucketLine *line = bucketLine;
+	machine index = line->FindLineElement(element, fingerprint);
+	while (index < 0)
+	{
+		line = line->nextLine;
+		index = line->FindLineElement(element, fingerprint);
+	}
+
+	// The hole is filled with the final entry in the bucket so that all lines but the last stay full.
+
+	HashTableBucketLine *lastLine = line;
+	while (lastLine->nextLine)
+	{
+		lastLine = lastLine->nextLine;
+	}
+
+	machine lastIndex = lastLine->lineEntryCount - 1;
+	line->lineElement[index] = lastLine->lineElement[lastIndex];
+	line->lineFingerprint[index] = lastLine->lineFingerprint[lastIndex];
+	lastLine->lineEntryCount = uint8(lastIndex);
+
+	if ((lastIndex == 0) && (lastLine != bucketLine))
+	{
+		HashTableBucketLine *prevLine = bucketLine;
+		while (prevLine->nextLine != lastLine)
+		{
+			prevLine = prevLine->nextLine;
+		}
+
+		prevLine->nextLine = nullptr;
+		DeleteBucketLine(lastLine);
+	}
+}
+
+void HashTableBucket::ResetBucketLines(void)
+{
+	HashTableBucketLine *line = bucketLine->nextLine;
+	while (line)
+	{
+		HashTableBucketLine *next = line->nextLine;
+		DeleteBucketLine(line);
+		line = next;
+	}
+
+	bucketLine->nextLine = nullptr;
+	bucketLine->lineEntryCount = 0;
+}
+
 void HashTableBucket::AppendBucketElement(HashTableElementBase *element)
 {
 	if (lastBucketElement)
@@ -48,6 +143,11 @@ void HashTableBucket::AppendBucketElement(HashTableElementBase *element)
 
 	element->owningHashTableBucket = this;
 	owningHashTable->elementCount++;
+
+	if (bucketLine)
+	{
+		AddLineElement(element);
+	}
 }
 
 void HashTableBucket::InsertBucketElementAfter(HashTableElementBase *element, HashTableElementBase *after)
@@ -69,12 +169,22 @@ void HashTableBucket::InsertBucketElementAfter(HashTableElementBase *element, Ha
 
 	element->owningHashTableBucket = this;
 	owningHashTable->elementCount++;
+
+	if (bucketLine)
+	{
+		AddLineElement(element);
+	}
 }
 
 void HashTableBucket::RemoveBucketElement(HashTableElementBase *element)
 {
 	owningHashTable->elementCount--;
 
+	if (bucketLine)
+	{
+		RemoveLineElement(element);
+	}
+
 	HashTableElementBase *prev = element->prevBucketElement;
 	HashTableElementBase *next = element->nextBucketElement;
 
@@ -117,6 +227,11 @@ void HashTableBucket::RemoveAllBucketElements(void)
 
 	firstBucketElement = nullptr;
 	lastBucketElement = nullptr;
+
+	if (bucketLine)
+	{
+		ResetBucketLines();
+	}
 }
 
 void HashTableBucket::PurgeBucket(void)
@@ -128,7 +243,7 @@ void HashTableBucket::PurgeBucket(void)
 }
 
 
-HashTableBase::HashTableBase(int32 initialBucketCount, int32 maxAverageDepth)
+HashTableBase::HashTableBase(int32 initialBucketCount, int32 maxAverageDepth, int32 resizeStep, HashTableLayout layout)
 {
 	#ifdef TERATHON_TOOLS
 
@@ -139,26 +254,140 @@ HashTableBase::HashTableBase(int32 initialBucketCount, int32 maxAverageDepth)
 	elementCount = 0;
 	bucketCount = initialBucketCount;
 	resizeLimit = initialBucketCount * maxAverageDepth;
+	resizeStepCount = resizeStep;
+	hashTableLayout = layout;
 
-	bucketTable = reinterpret_cast<HashTableBucket *>(new char[sizeof(HashTableBucket) * initialBucketCount]);
-	for (machine a = 0; a < initialBucketCount; a++)
+	bucketTable = NewBucketTable(this, initialBucketCount);
+
+	oldBucketTable = nullptr;
+	oldBucketCount = 0;
+	migrationIndex = 0;
+}
+
+HashTableBase::~HashTableBase()
+{
+	if (oldBucketTable)
 	{
-		new(&bucketTable[a]) HashTableBucket(this);
+		DeleteBucketTable(oldBucketTable, oldBucketCount);
 	}
+
+	DeleteBucketTable(bucketTable, bucketCount);
 }
 
-HashTableBase::~HashTableBase()
+HashTableBucket *HashTableBase::NewBucketTable(HashTableBase *hashTable, int32 count)
 {
-	for (machine a = bucketCount - 1; a >= 0; a--)
+	if (hashTable->hashTableLayout == kHashTableLayoutFingerprint)
+	{
+		// The first line of each bucket is stored in the same allocation after the buckets
+		// themselves, aligned to a cache line boundary.
+
+		machine bucketSize = sizeof(HashTableBucket) * count;
+		char *storage = new char[bucketSize + sizeof(HashTableBucketLine) * count + (kHashTableLineSize - 1)];
+
+		HashTableBucket *table = reinterpret_cast<HashTableBucket *>(storage);
+		HashTableBucketLine *line = reinterpret_cast<HashTableBucketLine *>((reinterpret_cast<machine_address>(storage + bucketSize) + (kHashTableLineSize - 1)) & ~machine_address(kHashTableLineSize - 1));
+
+		for (machine a = 0; a < count; a++)
+		{
+			line[a].nextLine = nullptr;
+			line[a].lineEntryCount = 0;
+			new(&table[a]) HashTableBucket(hashTable, &line[a]);
+		}
+
+		return (table);
+	}
+
+	HashTableBucket *table = reinterpret_cast<HashTableBucket *>(new char[sizeof(HashTableBucket) * count]);
+	for (machine a = 0; a < count; a++)
+	{
+		new(&table[a]) HashTableBucket(hashTable);
+	}
+
+	return (table);
+}
+
+void HashTableBase::DeleteBucketTable(HashTableBucket *table, int32 count)
+{
+	for (machine a = count - 1; a >= 0; a--)
+	{
+		table[a].~HashTableBucket();
+	}
+
+	delete[] reinterpret_cast<char *>(table);
+}
+
+void HashTableBase::MoveBucketElements(HashTableBucket *bucket)
+{
+	// Every element in one bucket of the old table lands in one of two buckets of the new table,
+	// so the relative order of elements having the same key is preserved.
+
+	HashTableElementBase *element = bucket->firstBucketElement;
+	if (element)
+	{
+		int32 count = elementCount;
+		do
+		{
+			HashTableElementBase *next = element->nextBucketElement;
+
+			element->prevBucketElement = nullptr;
+			element->nextBucketElement = nullptr;
+			bucketTable[element->hashValue & (bucketCount - 1)].AppendBucketElement(element);
+
+			element = next;
+		} while (element);
+
+		bucket->firstBucketElement = nullptr;
+		bucket->lastBucketElement = nullptr;
+		elementCount = count;
+
+		if (bucket->bucketLine)
+		{
+			bucket->ResetBucketLines();
+		}
+	}
+}
+
+void HashTableBase::MigrateBuckets(int32 count)
+{
+	int32 index = migrationIndex;
+	int32 limit = oldBucketCount;
+	if (count < limit - index)
+	{
+		limit = index + count;
+	}
+	for (; index < limit; index++)
 	{
-		bucketTable[a].~HashTableBucket();
+		MoveBucketElements(&oldBucketTable[index]);
 	}
 
-	delete[] reinterpret_cast<char *>(bucketTable);
+	migrationIndex = index;
+	if (index == oldBucketCount)
+	{
+		ReleaseOldBucketTable();
+	}
+}
+
+void HashTableBase::ReleaseOldBucketTable(void)
+{
+	DeleteBucketTable(oldBucketTable, oldBucketCount);
+
+	oldBucketTable = nullptr;
+	oldBucketCount = 0;
+	migrationIndex = 0;
 }
 
 void HashTableBase::RemoveAllHashTableElements(void)
 {
+	if (oldBucketTable)
+	{
+		for (machine a = oldBucketCount - 1; a >= 0; a--)
+		{
+			oldBucketTable[a].RemoveAllBucketElements();
+		}
+
+		ReleaseOldBucketTable();
+	}
+
 	for (machine a = bucketCount - 1; a >= 0; a--)
 	{
 		bucketTable[a].RemoveAllBucketElements();
@@ -169,6 +398,16 @@ void HashTableBase::RemoveAllHashTableElements(void)
 
 void HashTableBase::PurgeHashTable(void)
 {
+	if (oldBucketTable)
+	{
+		for (machine a = oldBucketCount - 1; a >= 0; a--)
+		{
+			oldBucketTable[a].PurgeBucket();
+		}
+
+		ReleaseOldBucketTable();
+	}
+
 	for (machine a = bucketCount - 1; a >= 0; a--)
 	{
 		bucketTable[a].PurgeBucket();
@@ -177,41 +416,45 @@ void HashTableBase::PurgeHashTable(void)
 	elementCount = 0;
 }
 
-void HashTableBase::ResizeBucketTable(void)
+void HashTableBase::FinishHashTableResize(void)
 {
-	int32 newBucketCount = bucketCount * 2;
-	HashTableBucket *newBucketTable = reinterpret_cast<HashTableBucket *>(new char[sizeof(HashTableBucket) * newBucketCount]);
-	for (machine a = 0; a < newBucketCount; a++)
+	if (oldBucketTable)
 	{
-		new(&newBucketTable[a]) HashTableBucket(this);
+		MigrateBuckets(oldBucketCount);
 	}
+}
 
-	elementCount = 0;
+void HashTableBase::ResizeBucketTable(void)
+{
+	// If an incremental resize is still in progress, it has to be completed before the
+	// bucket table can be expanded again because only one old table is kept at a time.
 
-	int32 count = bucketCount;
-	for (machine a = count - 1; a >= 0; a--)
-	{
-		HashTableBucket *bucket = &bucketTable[a];
-		HashTableElementBase *element = bucket->firstBucketElement;
-		while (element)
-		{
-			HashTableElementBase *next = element->nextBucketElement;
+	FinishHashTableResize();
 
-			element->prevBucketElement = nullptr;
-			element->nextBucketElement = nullptr;
-			newBucketTable[element->hashValue & (newBucketCount - 1)].AppendBucketElement(element);
+	oldBucketTable = bucketTable;
+	oldBucketCount = bucketCount;
+	migrationIndex = 0;
 
-			element = next;
-		}
+	bucketCount *= 2;
+	bucketTable = NewBucketTable(this, bucketCount);
+	resizeLimit *= 2;
 
-		bucket->firstBucketElement = nullptr;
-		bucket->lastBucketElement = nullptr;
-		bucket->~HashTableBucket();
+	if (resizeStepCount <= 0)
+	{
+		MigrateBuckets(oldBucketCount);
 	}
+}
+
+HashTableBucket *HashTableBase::PrepareInsertionBucket(uint32 hashValue)
+{
+	// The old bucket corresponding to the hash value is migrated before a new element is inserted
+	// so that elements having the same key are never divided between the old and new tables.
 
-	delete[] reinterpret_cast<char *>(bucketTable);
+	if (oldBucketTable)
+	{
+		MoveBucketElements(GetOldBucket(hashValue));
+		MigrateBuckets(resizeStepCount);
+	}
 
-	bucketTable = newBucketTable;
-	bucketCount = newBucketCount;
-	resizeLimit *= 2;
+	return (GetBucket(hashValue));
 }
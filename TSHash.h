@@ -23,10 +23,66 @@
 
 namespace Terathon
 {
+	typedef uint32 HashTableLayout;
+
+
+	//# \enum	HashTableLayout
+
+	enum : HashTableLayout
+	{
+		kHashTableLayoutList,				//## Each bucket is a linked list of its elements.
+		kHashTableLayoutFingerprint			//## Each bucket also stores element pointers and hash fingerprints in cache-line sized blocks.
+	};
+
+
+	enum
+	{
+		kHashTableLineSize			= 64,
+		kHashTableLineEntryCount	= (kHashTableLineSize - sizeof(void *) - 1) / (sizeof(void *) + 1)
+	};
+
+
+	class HashTableElementBase;
 	class HashTableBucket;
 	class HashTableBase;
 
 
+	// A bucket line holds the elements of one bucket together with an 8-bit fingerprint of each
+	// element's hash value so that most mismatches are rejected without touching the elements.
+	// Entries are unordered, and every line except the last one in a chain is full.
+
+	struct alignas(kHashTableLineSize) HashTableBucketLine
+	{
+		HashTableElementBase	*lineElement[kHashTableLineEntryCount];
+		HashTableBucketLine		*nextLine;
+		uint8					lineFingerprint[kHashTableLineEntryCount];
+		uint8					lineEntryCount;
+
+		static uint8 GetFingerprint(uint32 hashValue)
+		{
+			// The bucket index uses the low bits of the hash value, so the fingerprint is taken
+			// from the high bits of a multiplicative mix that depends on all of them.
+
+			return (uint8((hashValue * 0x9E3779B1U) >> 24));
+		}
+
+		machine FindLineElement(const HashTableElementBase *element, uint8 fingerprint) const
+		{
+			for (machine a = 0; a < lineEntryCount; a++)
+			{
+				if ((lineFingerprint[a] == fingerprint) && (lineElement[a] == element))
+				{
+					return (a);
+				}
+			}
+
+			return (-1);
+		}
+	};
+
+	static_assert(sizeof(HashTableBucketLine) == kHashTableLineSize, "HashTableBucketLine must occupy exactly one cache line");
+
+
 	class HashTableElementBase
 	{
 		friend class HashTableBucket;
@@ -75,22 +131,34 @@ namespace Terathon
 	{
 		friend class HashTableBase;
 
+		template <class type>
+		friend class HashTable;
+
 		private:
 
 			HashTableElementBase	*firstBucketElement;
 			HashTableElementBase	*lastBucketElement;
 			HashTableBase			*owningHashTable;
+			HashTableBucketLine		*bucketLine;
+
+			static HashTableBucketLine *NewBucketLine(void);
+			static void DeleteBucketLine(HashTableBucketLine *line);
+
+			void AddLineElement(HashTableElementBase *element);
+			void RemoveLineElement(HashTableElementBase *element);
+			void ResetBucketLines(void);
 
 			void RemoveAllBucketElements(void);
 			void PurgeBucket(void);
 
 		public:
 
-			HashTableBucket(HashTableBase *hashTable)
+			HashTableBucket(HashTableBase *hashTable, HashTableBucketLine *line = nullptr)
 			{
 				firstBucketElement = nullptr;
 				lastBucketElement = nullptr;
 				owningHashTable = hashTable;
+				bucketLine = line;
 			}
 
 			~HashTableBucket();
@@ -123,24 +191,47 @@ namespace Terathon
 			int32				elementCount;
 			int32				bucketCount;
 			int32				resizeLimit;
+			int32				resizeStepCount;
+			HashTableLayout		hashTableLayout;
 
 			HashTableBucket		*bucketTable;
 
+			HashTableBucket		*oldBucketTable;
+			int32				oldBucketCount;
+			int32				migrationIndex;
+
 			HashTableBase(const HashTableBase&) = delete;
 			HashTableBase& operator =(const HashTableBase&) = delete;
 
+			static HashTableBucket *NewBucketTable(HashTableBase *hashTable, int32 count);
+			static void DeleteBucketTable(HashTableBucket *table, int32 count);
+
+			void MoveBucketElements(HashTableBucket *bucket);
+			void MigrateBuckets(int32 count);
+			void ReleaseOldBucketTable(void);
+
 		protected:
 
-			TERATHON_API HashTableBase(int32 initialBucketCount, int32 maxAverageDepth);
+			TERATHON_API HashTableBase(int32 initialBucketCount, int32 maxAverageDepth, int32 resizeStep, HashTableLayout layout);
 			TERATHON_API virtual ~HashTableBase();
 
 			HashTableElementBase *GetFirstBucketElement(int32 index) const
 			{
+				if (oldBucketTable)
+				{
+					const_cast<HashTableBase *>(this)->FinishHashTableResize();
+				}
+
 				return (bucketTable[index].GetFirstBucketElement());
 			}
 
 			HashTableElementBase *GetLastBucketElement(int32 index) const
 			{
+				if (oldBucketTable)
+				{
+					const_cast<HashTableBase *>(this)->FinishHashTableResize();
+				}
+
 				return (bucketTable[index].GetLastBucketElement());
 			}
 
@@ -149,7 +240,21 @@ namespace Terathon
 				return (&bucketTable[hashValue & (bucketCount - 1)]);
 			}
 
+			HashTableBucket *GetOldBucket(uint32 hashValue) const
+			{
+				return ((oldBucketTable) ? &oldBucketTable[hashValue & (oldBucketCount - 1)] : nullptr);
+			}
+
+			void StepHashTableResize(void)
+			{
+				if (oldBucketTable)
+				{
+					MigrateBuckets(resizeStepCount);
+				}
+			}
+
 			TERATHON_API void ResizeBucketTable(void);
+			TERATHON_API HashTableBucket *PrepareInsertionBucket(uint32 hashValue);
 
 		public:
 
@@ -163,8 +268,19 @@ namespace Terathon
 				return (bucketCount);
 			}
 
+			HashTableLayout GetHashTableLayout(void) const
+			{
+				return (hashTableLayout);
+			}
+
+			bool GetHashTableResizeFlag(void) const
+			{
+				return (oldBucketTable != nullptr);
+			}
+
 			TERATHON_API void RemoveAllHashTableElements(void);
 			TERATHON_API void PurgeHashTable(void);
+			TERATHON_API void FinishHashTableResize(void);
 	};
 
 
@@ -217,10 +333,13 @@ namespace Terathon
 	//#						by this parameter should inherit directly from the $@HashTableElement@$ class
 	//#						using the same template parameter.
 	//
-	//# \ctor	HashTable(int32 initialBucketCount, int32 maxAverageDepth);
+	//# \ctor	HashTable(int32 initialBucketCount, int32 maxAverageDepth, int32 resizeStep = 0, HashTableLayout layout = kHashTableLayoutList);
 	//
 	//# \param	initialBucketCount		The number of buckets initially used by the hash table. This must be a power of two.
 	//# \param	maxAverageDepth			The maximum average size of each bucket allowed before the hash table is expanded.
+	//# \param	resizeStep				The number of old buckets migrated by each operation while the hash table is being expanded.
+	//#									If this is zero, then the hash table is expanded all at once.
+	//# \param	layout					The bucket layout used by the hash table. See below for possible values.
 	//
 	//# \desc
 	//# The $HashTable$ class template is a container used to organize a homogeneous set of objects.
@@ -233,6 +352,26 @@ namespace Terathon
 	//# exceeds the value specified by the $maxAverageDepth$ parameter, the number of buckets is doubled, and the elements of
 	//# the hash table are redistributed among the larger set of buckets.
 	//#
+	//# By default, all of the elements are redistributed during the call to $@HashTable::InsertHashTableElement@$ that
+	//# causes the hash table to be expanded, which can take a long time for a large hash table. If the $resizeStep$
+	//# parameter is greater than zero, then the hash table is instead expanded incrementally. The old set of buckets is
+	//# kept alongside the new set, and each subsequent call to $@HashTable::InsertHashTableElement@$,
+	//# $@HashTable::FindHashTableElement@$, or $@HashTable::RemoveHashTableElement@$ moves the elements of $resizeStep$
+	//# old buckets into the new set. Lookups search both sets of buckets until the old set is empty, at which point it
+	//# is deleted. Accessing the buckets directly, or calling the $@HashTable::FinishHashTableResize@$ function, completes
+	//# the expansion immediately.
+	//#
+	//# The $layout$ parameter can be one of the following constants.
+	//#
+	//# \table	HashTableLayout
+	//#
+	//# With the $kHashTableLayoutFingerprint$ layout, each bucket additionally stores pointers to its elements in
+	//# cache-line sized blocks along with an 8-bit fingerprint of each element's hash value, and further blocks are
+	//# chained to a bucket when it overflows. A search compares keys only for elements whose fingerprint matches,
+	//# so most unsuccessful searches finish after reading a single cache line instead of visiting every element in the
+	//# bucket. This costs an extra 64 bytes per bucket and makes insertion and removal slightly slower. The order of
+	//# elements within each bucket and the results of all searches are the same for both layouts.
+	//#
 	//# When a $HashTable$ object is destroyed, all of the members of the hash table are also destroyed. To avoid deleting
 	//# the members of a hash table when a $HashTable$ object is destroyed, first call the $@HashTable::RemoveAllHashTableElements@$
 	//# function to remove all of the hash table's members.
@@ -337,6 +476,22 @@ namespace Terathon
 	//# \also	$@HashTable::RemoveHashTableElement@$
 
 
+	//# \function	HashTable::FinishHashTableResize		Completes an incremental expansion of a hash table.
+	//
+	//# \proto	void FinishHashTableResize(void);
+	//
+	//# \desc
+	//# The $FinishHashTableResize$ function moves all of the elements remaining in the old set of buckets into the new
+	//# set of buckets and deletes the old set. It has an effect only if the hash table was constructed with a nonzero
+	//# $resizeStep$ parameter and an expansion is still in progress. This can be called at a convenient time to
+	//# avoid spreading the remaining work over subsequent operations. The $GetHashTableResizeFlag$ function returns
+	//# $true$ if an expansion is in progress.
+	//
+	//# \proto	bool GetHashTableResizeFlag(void) const;
+	//
+	//# \also	$@HashTable::InsertHashTableElement@$
+
+
 	template <class type>
 	class HashTable : public HashTableBase
 	{
@@ -344,9 +499,16 @@ namespace Terathon
 
 			typedef typename type::KeyType		KeyType;
 
+			static bool MatchBucketElement(const HashTableElementBase *element, const KeyType& key, uint32 hash)
+			{
+				return ((element->hashValue == hash) && (static_cast<const type *>(static_cast<const HashTableElement<type> *>(element))->GetKey() == key));
+			}
+
+			static HashTableElementBase *FindBucketElement(const HashTableBucket *bucket, const KeyType& key, uint32 hash);
+
 		public:
 
-			HashTable(int32 initialBucketCount, int32 maxAverageDepth);
+			HashTable(int32 initialBucketCount, int32 maxAverageDepth, int32 resizeStep = 0, HashTableLayout layout = kHashTableLayoutList);
 			~HashTable();
 
 			type *GetFirstBucketElement(int32 index) const
@@ -364,7 +526,9 @@ namespace Terathon
 				HashTableBucket *bucket = element->owningHashTableBucket;
 				if (bucket)
 				{
+					HashTableBase *hashTable = bucket->owningHashTable;
 					bucket->RemoveBucketElement(element);
+					hashTable->StepHashTableResize();
 				}
 			}
 
@@ -375,7 +539,7 @@ namespace Terathon
 
 
 	template <class type>
-	HashTable<type>::HashTable(int32 initialBucketCount, int32 maxAverageDepth) : HashTableBase(initialBucketCount, maxAverageDepth)
+	HashTable<type>::HashTable(int32 initialBucketCount, int32 maxAverageDepth, int32 resizeStep, HashTableLayout layout) : HashTableBase(initialBucketCount, maxAverageDepth, resizeStep, layout)
 	{
 	}
 
@@ -404,41 +568,107 @@ namespace Terathon
 		uint32 hash = type::Hash(key);
 		element->hashValue = hash;
 
-		bucket = GetBucket(hash);
-		HashTableElementBase *after = bucket->GetLastBucketElement();
-		while (after)
+		bucket = PrepareInsertionBucket(hash);
+		HashTableElementBase *after = FindBucketElement(bucket, key, hash);
+		if (after)
 		{
-			type *object = static_cast<type *>(static_cast<HashTableElement<type> *>(after));
-			if (object->GetKey() == key)
+			// Elements having the same key are adjacent, and the new element goes after the last of them.
+
+			for (;;)
 			{
-				bucket->InsertBucketElementAfter(element, after);
-				return;
+				HashTableElementBase *next = after->GetNextBucketElement();
+				if ((!next) || (!MatchBucketElement(next, key, hash)))
+				{
+					break;
+				}
+
+				after = next;
 			}
 
-			after = after->GetPreviousBucketElement();
+			bucket->InsertBucketElementAfter(element, after);
+		}
+		else
+		{
+			bucket->AppendBucketElement(element);
 		}
-
-		bucket->AppendBucketElement(element);
 	}
 
 	template <class type>
-	type *HashTable<type>::FindHashTableElement(const KeyType& key) const
+	HashTableElementBase *HashTable<type>::FindBucketElement(const HashTableBucket *bucket, const KeyType& key, uint32 hash)
 	{
-		const HashTableBucket *bucket = GetBucket(type::Hash(key));
-		HashTableElementBase *element = bucket->GetFirstBucketElement();
-		while (element)
+		const HashTableBucketLine *line = bucket->bucketLine;
+		if (line)
 		{
-			type *object = static_cast<type *>(static_cast<HashTableElement<type> *>(element));
-			if (object->GetKey() == key)
+			// Only elements whose fingerprint matches are examined. Line entries are unordered, so after
+			// a match is found, earlier elements in the bucket having the same key are also considered.
+
+			uint8 fingerprint = HashTableBucketLine::GetFingerprint(hash);
+			do
 			{
-				return (object);
-			}
+				machine count = line->lineEntryCount;
+				for (machine a = 0; a < count; a++)
+				{
+					if (line->lineFingerprint[a] == fingerprint)
+					{
+						HashTableElementBase *element = line->lineElement[a];
+						if (MatchBucketElement(element, key, hash))
+						{
+							for (;;)
+							{
+								HashTableElementBase *prev = element->GetPreviousBucketElement();
+								if ((!prev) || (!MatchBucketElement(prev, key, hash)))
+								{
+									break;
+								}
+
+								element = prev;
+							}
+
+							return (element);
+						}
+					}
+				}
+
+				line = line->nextLine;
+			} while (line);
+		}
+		else
+		{
+			HashTableElementBase *element = bucket->GetFirstBucketElement();
+			while (element)
+			{
+				if (MatchBucketElement(element, key, hash))
+				{
+					return (element);
+				}
 
-			element = element->GetNextBucketElement();
+				element = element->GetNextBucketElement();
+			}
 		}
 
 		return (nullptr);
 	}
+
+	template <class type>
+	type *HashTable<type>::FindHashTableElement(const KeyType& key) const
+	{
+		// While the hash table is being expanded, an element can still be in the old set of
+		// buckets, so both sets are searched. Elements with the same key are always in the same set.
+
+		const_cast<HashTable *>(this)->StepHashTableResize();
+
+		uint32 hash = type::Hash(key);
+		const HashTableBucket *bucket = GetBucket(hash);
+		const HashTableBucket *oldBucket = GetOldBucket(hash);
+
+		HashTableElementBase *element = FindBucketElement(bucket, key, hash);
+		if ((!element) && (oldBucket))
+		{
+			element = FindBucketElement(oldBucket, key, hash);
+		}
+
+		return (static_cast<type *>(static_cast<HashTableElement<type> *>(element)));
+	}
 }
 
 
@@ -0,0 +1,367 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#include "TSMappedArray.h"
+
+#if defined(_WIN32)
+
+	#include <windows.h>
+
+#else
+
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+
+#endif
+
+
+using namespace Terathon;
+
+
+namespace
+{
+	enum
+	{
+		// Extended files are rounded up to this size, which is a multiple of the
+		// page size and of the allocation granularity on all supported systems.
+
+		kMappedFileGranularity = 65536
+	};
+}
+
+
+MappedArrayBase::MappedArrayBase()
+{
+	fileHandle = -1;
+	mappingHandle = 0;
+	mappedFlags = 0;
+	mappedElementSize = 1;
+	mappedSize = 0;
+	mappedPointer = nullptr;
+}
+
+MappedArrayBase::~MappedArrayBase()
+{
+	CloseMappedFile();
+}
+
+bool MappedArrayBase::MapFile(umachine size)
+{
+	bool write = ((mappedFlags & kMappedArrayWrite) != 0);
+
+	#if defined(_WIN32)
+
+		HANDLE mapping = CreateFileMappingA(reinterpret_cast<HANDLE>(fileHandle), nullptr, (write) ? PAGE_READWRITE : PAGE_READONLY, DWORD(uint64(size) >> 32), DWORD(size), nullptr);
+		if (!mapping)
+		{
+			return (false);
+		}
+
+		void *pointer = MapViewOfFile(mapping, (write) ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+		if (!pointer)
+		{
+			CloseHandle(mapping);
+			return (false);
+		}
+
+		mappingHandle = reinterpret_cast<machine>(mapping);
+
+	#else
+
+		void *pointer = mmap(nullptr, size, (write) ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, int(fileHandle), 0);
+		if (pointer == MAP_FAILED)
+		{
+			return (false);
+		}
+
+	#endif
+
+	mappedPointer = static_cast<char *>(pointer);
+	mappedSize = size;
+	return (true);
+}
+
+void MappedArrayBase::UnmapFile(void)
+{
+	#if defined(_WIN32)
+
+		UnmapViewOfFile(mappedPointer);
+		CloseHandle(reinterpret_cast<HANDLE>(mappingHandle));
+		mappingHandle = 0;
+
+	#else
+
+		munmap(mappedPointer, mappedSize);
+
+	#endif
+
+	mappedPointer = nullptr;
+	mappedSize = 0;
+}
+
+MappedArrayResult MappedArrayBase::OpenMappedFile(const char *name, uint32 flags, uint32 elementSize)
+{
+	if (flags & kMappedArrayCreate)
+	{
+		flags |= kMappedArrayWrite;
+	}
+
+	bool write = ((flags & kMappedArrayWrite) != 0);
+	uint64 fileSize = 0;
+
+	#if defined(_WIN32)
+
+		HANDLE file = CreateFileA(name, (write) ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr, (flags & kMappedArrayCreate) ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return ((GetLastError() == ERROR_ACCESS_DENIED) ? kMappedArrayAccessDenied : kMappedArrayOpenFailed);
+		}
+
+		LARGE_INTEGER	size;
+
+		GetFileSizeEx(file, &size);
+		fileSize = uint64(size.QuadPart);
+
+		if ((fileSize == 0) && (write))
+		{
+			size.QuadPart = kMappedArrayHeaderSize;
+			SetFilePointerEx(file, size, nullptr, FILE_BEGIN);
+			SetEndOfFile(file);
+			fileSize = kMappedArrayHeaderSize;
+		}
+
+		fileHandle = reinterpret_cast<machine>(file);
+
+	#else
+
+		int file = open(name, (write) ? O_RDWR | ((flags & kMappedArrayCreate) ? O_CREAT : 0) : O_RDONLY, 0644);
+		if (file < 0)
+		{
+			return (((errno == EACCES) || (errno == EPERM)) ? kMappedArrayAccessDenied : kMappedArrayOpenFailed);
+		}
+
+		struct stat		status;
+
+		fstat(file, &status);
+		fileSize = uint64(status.st_size);
+
+		if ((fileSize == 0) && (write))
+		{
+			if (ftruncate(file, kMappedArrayHeaderSize) != 0)
+			{
+				close(file);
+				return (kMappedArrayOpenFailed);
+			}
+
+			fileSize = kMappedArrayHeaderSize;
+		}
+
+		fileHandle = file;
+
+	#endif
+
+	mappedFlags = flags;
+	mappedElementSize = elementSize;
+
+	MappedArrayResult result = kMappedArrayFormatInvalid;
+	if ((fileSize >= kMappedArrayHeaderSize) && (fileSize <= uint64(~umachine(0))))
+	{
+		result = kMappedArrayMapFailed;
+		if (MapFile(umachine(fileSize)))
+		{
+			MappedArrayHeader *header = GetMappedHeader();
+			if (header->fileSignature == 0)
+			{
+				// A zero signature only occurs in a file that was just created above, or in one
+				// that was created but never initialized, so a fresh header is written into it.
+
+				if ((write) && (header->elementCount == 0))
+				{
+					header->fileSignature = kMappedArraySignature;
+					header->formatVersion = kMappedArrayVersion;
+					header->headerSize = kMappedArrayHeaderSize;
+					header->elementSize = elementSize;
+				}
+			}
+
+			if (header->fileSignature != kMappedArraySignature)
+			{
+				result = kMappedArrayFormatInvalid;
+			}
+			else if (header->formatVersion > kMappedArrayVersion)
+			{
+				result = kMappedArrayVersionUnsupported;
+			}
+			else if (header->headerSize != kMappedArrayHeaderSize)
+			{
+				result = kMappedArrayFormatInvalid;
+			}
+			else if (header->elementSize != elementSize)
+			{
+				result = kMappedArrayElementSizeMismatch;
+			}
+			else
+			{
+				return (kMappedArrayOkay);
+			}
+
+			UnmapFile();
+		}
+	}
+
+	#if defined(_WIN32)
+
+		CloseHandle(file);
+
+	#else
+
+		close(file);
+
+	#endif
+
+	fileHandle = -1;
+	mappedFlags = 0;
+	mappedElementSize = 1;
+	return (result);
+}
+
+void MappedArrayBase::CloseMappedFile(void)
+{
+	if (mappedPointer)
+	{
+		uint64 fileSize = mappedSize;
+		if (mappedFlags & kMappedArrayWrite)
+		{
+			fileSize = kMappedArrayHeaderSize + GetMappedHeader()->elementCount * mappedElementSize;
+		}
+
+		UnmapFile();
+
+		#if defined(_WIN32)
+
+			HANDLE file = reinterpret_cast<HANDLE>(fileHandle);
+			if (mappedFlags & kMappedArrayWrite)
+			{
+				LARGE_INTEGER	size;
+
+				size.QuadPart = LONGLONG(fileSize);
+				SetFilePointerEx(file, size, nullptr, FILE_BEGIN);
+				SetEndOfFile(file);
+			}
+
+			CloseHandle(file);
+
+		#else
+
+			if (mappedFlags & kMappedArrayWrite)
+			{
+				if (ftruncate(int(fileHandle), off_t(fileSize)) != 0)
+				{
+					// If the file can't be trimmed, it keeps the unused capacity past the last element.
+					// The file is still valid because the header records the element count, and the
+					// extra space is reused the next time the file is opened for writing.
+				}
+			}
+
+			close(int(fileHandle));
+
+		#endif
+
+		fileHandle = -1;
+		mappedFlags = 0;
+		mappedElementSize = 1;
+	}
+}
+
+bool MappedArrayBase::ExtendMappedFile(uint64 capacity)
+{
+	if ((!mappedPointer) || (!(mappedFlags & kMappedArrayWrite)))
+	{
+		return (false);
+	}
+
+	if (capacity <= GetMappedCapacity())
+	{
+		return (true);
+	}
+
+	uint64 maxCapacity = (uint64(~umachine(0)) - (kMappedArrayHeaderSize + kMappedFileGranularity)) / mappedElementSize;
+	if (capacity > maxCapacity)
+	{
+		return (false);
+	}
+
+	uint64 newSize = (kMappedArrayHeaderSize + capacity * mappedElementSize + (kMappedFileGranularity - 1)) & ~uint64(kMappedFileGranularity - 1);
+	umachine oldSize = mappedSize;
+	UnmapFile();
+
+	#if defined(_WIN32)
+
+		// Creating a mapping larger than the file extends the file with zeros.
+
+		if (MapFile(umachine(newSize)))
+		{
+			return (true);
+		}
+
+	#else
+
+		if ((ftruncate(int(fileHandle), off_t(newSize)) == 0) && (MapFile(umachine(newSize))))
+		{
+			return (true);
+		}
+
+		// The file is restored to its previous size. If that fails, the old mapping below still
+		// fits inside the file, so the result is deliberately ignored.
+
+		if (ftruncate(int(fileHandle), off_t(oldSize)) != 0)
+		{
+		}
+
+	#endif
+
+	if (!MapFile(oldSize))
+	{
+		#if defined(_WIN32)
+
+			CloseHandle(reinterpret_cast<HANDLE>(fileHandle));
+
+		#else
+
+			close(int(fileHandle));
+
+		#endif
+
+		fileHandle = -1;
+		mappedFlags = 0;
+		mappedElementSize = 1;
+	}
+
+	return (false);
+}
+
+void MappedArrayBase::FlushMappedFile(void)
+{
+	if ((mappedPointer) && (mappedFlags & kMappedArrayWrite))
+	{
+		#if defined(_WIN32)
+
+			FlushViewOfFile(mappedPointer, 0);
+			FlushFileBuffers(reinterpret_cast<HANDLE>(fileHandle));
+
+		#else
+
+			msync(mappedPointer, mappedSize, MS_SYNC);
+
+		#endif
+	}
+}
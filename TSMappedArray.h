@@ -0,0 +1,444 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSMappedArray_h
+#define TSMappedArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_MAPPEDARRAY 1
+
+
+namespace Terathon
+{
+	typedef uint32	MappedArrayResult;
+
+
+	enum : MappedArrayResult
+	{
+		kMappedArrayOkay,
+		kMappedArrayOpenFailed,
+		kMappedArrayMapFailed,
+		kMappedArrayFormatInvalid,
+		kMappedArrayVersionUnsupported,
+		kMappedArrayElementSizeMismatch,
+		kMappedArrayAccessDenied
+	};
+
+
+	enum
+	{
+		kMappedArrayWrite		= 1 << 0,
+		kMappedArrayCreate		= 1 << 1
+	};
+
+
+	enum
+	{
+		kMappedArraySignature	= 0x414D5354,		// 'TSMA' when read as bytes in little-endian order.
+		kMappedArrayVersion		= 1,
+		kMappedArrayHeaderSize	= 64
+	};
+
+
+	// The MappedArrayHeader structure occupies the first kMappedArrayHeaderSize bytes of a file
+	// holding a mapped array, and the elements begin immediately after it.
+
+	struct MappedArrayHeader
+	{
+		uint32		fileSignature;
+		uint32		formatVersion;
+		uint32		headerSize;
+		uint32		elementSize;
+		uint64		elementCount;
+		uint64		reserved[5];
+	};
+
+
+	class MappedArrayBase
+	{
+		private:
+
+			machine					fileHandle;
+			machine					mappingHandle;
+			uint32					mappedFlags;
+			uint32					mappedElementSize;
+			umachine				mappedSize;
+			char					*mappedPointer;
+
+			bool MapFile(umachine size);
+			void UnmapFile(void);
+
+			MappedArrayBase(const MappedArrayBase&) = delete;
+			MappedArrayBase& operator =(const MappedArrayBase&) = delete;
+
+		protected:
+
+			TERATHON_API MappedArrayBase();
+			TERATHON_API ~MappedArrayBase();
+
+			MappedArrayHeader *GetMappedHeader(void) const
+			{
+				return (reinterpret_cast<MappedArrayHeader *>(mappedPointer));
+			}
+
+			char *GetMappedData(void) const
+			{
+				return (mappedPointer + kMappedArrayHeaderSize);
+			}
+
+			uint64 GetMappedCapacity(void) const
+			{
+				return ((mappedSize - kMappedArrayHeaderSize) / mappedElementSize);
+			}
+
+			TERATHON_API MappedArrayResult OpenMappedFile(const char *name, uint32 flags, uint32 elementSize);
+			TERATHON_API void CloseMappedFile(void);
+			TERATHON_API bool ExtendMappedFile(uint64 capacity);
+			TERATHON_API void FlushMappedFile(void);
+
+		public:
+
+			bool IsMappedArrayOpen(void) const
+			{
+				return (mappedPointer != nullptr);
+			}
+
+			bool IsMappedArrayWritable(void) const
+			{
+				return ((mappedFlags & kMappedArrayWrite) != 0);
+			}
+	};
+
+
+	//# \class	MappedArray		An array whose storage is a memory-mapped file.
+	//
+	//# The $MappedArray$ class template is an array whose elements are stored in a memory-mapped file.
+	//
+	//# \def	template <typename type, typename countType = int32> class MappedArray final : public MappedArrayBase, public ImmutableArray<type, countType>
+	//
+	//# \tparam		type		The type of the class that can be stored in the array. This must be trivially copyable.
+	//# \tparam		countType	The integer type used to hold element counts and indexes.
+	//
+	//# \ctor	MappedArray();
+	//
+	//# \desc
+	//# The $MappedArray$ class template provides the read interface of an $@ImmutableArray@$ object for elements stored
+	//# in a file that is mapped into memory with the $@MappedArray::OpenMappedArray@$ function. Opening the file takes constant
+	//# time because no element data is read up front. Pages of the file are loaded by the operating system as they are touched,
+	//# and they are shared with the file cache instead of being copied into private memory.
+	//#
+	//# The file begins with a 64-byte header that records a signature, a format version, the element size, and the element
+	//# count. The element size prevents a file from being opened as an array of the wrong type. Because of the header, elements
+	//# are aligned to 64 bytes in memory. The element data is stored in the byte order of the machine that wrote it. Because
+	//# the file contents are used directly, the $type$ template parameter must be a trivially copyable type that does not
+	//# contain pointers.
+	//#
+	//# When a file is opened with write access, elements can be modified in place, and the array can be enlarged with the
+	//# $@MappedArray::SetArrayElementCount@$ and $@MappedArray::AppendArrayElement@$ functions. Enlarging the array extends the
+	//# file and maps it again, which can change the address of the elements, so pointers to the elements are invalidated in
+	//# the same way that they would be for an ordinary $@Array@$ object. The file is extended geometrically, and any extra
+	//# space is trimmed when the file is closed. If a file is opened without write access, then the elements must not be
+	//# modified, and doing so generates an access violation.
+	//#
+	//# The file is closed automatically when the $MappedArray$ object is destroyed.
+	//
+	//# \base	ImmutableArray<type, countType>		A $MappedArray$ provides the read interface of an immutable array.
+	//
+	//# \also	$@Array@$
+
+
+	//# \function	MappedArray::OpenMappedArray		Opens a file and maps its contents as an array.
+	//
+	//# \proto	MappedArrayResult OpenMappedArray(const char *name, uint32 flags = 0);
+	//
+	//# \param	name	The name of the file to open.
+	//# \param	flags	The file access flags. See below.
+	//
+	//# \desc
+	//# The $OpenMappedArray$ function opens the file specified by the $name$ parameter and maps it into memory. The $flags$
+	//# parameter can be zero or a combination (through logical OR) of the constants $kMappedArrayWrite$, which opens the
+	//# file with write access, and $kMappedArrayCreate$, which creates the file if it does not exist and implies write access.
+	//#
+	//# If the file does not exist and the $kMappedArrayCreate$ flag is specified, then a new empty file is created. If the
+	//# file already exists, then its header is validated, and the function fails if the header does not have the right
+	//# signature or version or if the element size stored in it does not match the size of $type$.
+	//#
+	//# The return value is $kMappedArrayOkay$ if the file was successfully opened. Otherwise, it is one of the error codes
+	//# $kMappedArrayOpenFailed$, $kMappedArrayMapFailed$, $kMappedArrayFormatInvalid$, $kMappedArrayVersionUnsupported$,
+	//# $kMappedArrayElementSizeMismatch$, or $kMappedArrayAccessDenied$.
+	//#
+	//# If the $MappedArray$ object already has a file open, then it is closed before the new file is opened.
+	//
+	//# \also	$@MappedArray::CloseMappedArray@$
+
+
+	//# \function	MappedArray::CloseMappedArray		Closes the file mapped by an array.
+	//
+	//# \proto	void CloseMappedArray(void);
+	//
+	//# \desc
+	//# The $CloseMappedArray$ function unmaps the file previously opened by the $@MappedArray::OpenMappedArray@$ function
+	//# and closes it. If the file was opened with write access, then any unused space at the end of the file is removed.
+	//# After this function is called, the array is empty.
+	//
+	//# \also	$@MappedArray::OpenMappedArray@$
+
+
+	//# \function	MappedArray::FlushMappedArray		Writes modified elements back to the file.
+	//
+	//# \proto	void FlushMappedArray(void);
+	//
+	//# \desc
+	//# The $FlushMappedArray$ function waits until any modified pages of a writable mapped array have been written to the
+	//# file. This is not necessary for the file to be updated eventually, but it can be used to make sure the contents of the
+	//# file are durable at a particular time.
+
+
+	//# \function	MappedArray::ReserveArrayElementCount		Allocates space in the file for a specific number of elements.
+	//
+	//# \proto	bool ReserveArrayElementCount(countType count);
+	//
+	//# \param	count	The minimum number of elements for which space is reserved.
+	//
+	//# \desc
+	//# The $ReserveArrayElementCount$ function extends the file, if necessary, so that it can hold at least the number of
+	//# elements specified by the $count$ parameter. The number of elements in the array is not changed. The return value is
+	//# $true$ if the space is available and $false$ if the file is not writable or could not be extended.
+	//
+	//# \also	$@MappedArray::SetArrayElementCount@$
+
+
+	//# \function	MappedArray::SetArrayElementCount		Sets the number of elements in an array.
+	//
+	//# \proto	bool SetArrayElementCount(countType count);
+	//
+	//# \param	count	The new size of the array.
+	//
+	//# \desc
+	//# The $SetArrayElementCount$ function sets the number of elements in a writable mapped array and updates the element count
+	//# in the file header. If the array is enlarged, then the file is extended as necessary, and the new elements are zero
+	//# unless the space was previously used by the same file. The return value is $true$ if the count was changed and $false$
+	//# if the file is not writable or could not be extended.
+	//
+	//# \also	$@MappedArray::AppendArrayElement@$
+	//# \also	$@MappedArray::AppendArrayElements@$
+
+
+	//# \function	MappedArray::AppendArrayElement		Adds an element to the end of an array.
+	//
+	//# \proto	type *AppendArrayElement(const type& element);
+	//
+	//# \param	element		The new element to add to the array.
+	//
+	//# \desc
+	//# The $AppendArrayElement$ function increases the size of a writable mapped array by one and copies the value specified
+	//# by the $element$ parameter into the new element. The return value is a pointer to the new element, or $nullptr$ if the
+	//# file is not writable or could not be extended.
+	//
+	//# \also	$@MappedArray::AppendArrayElements@$
+
+
+	//# \function	MappedArray::AppendArrayElements		Adds multiple elements to the end of an array.
+	//
+	//# \proto	type *AppendArrayElements(const type *elements, countType count);
+	//
+	//# \param	elements	A pointer to the elements to add to the array.
+	//# \param	count		The number of elements to add.
+	//
+	//# \desc
+	//# The $AppendArrayElements$ function increases the size of a writable mapped array by the number of elements specified
+	//# by the $count$ parameter and copies the elements pointed to by the $elements$ parameter into the new space. The file is
+	//# extended at most once. The return value is a pointer to the first new element, or $nullptr$ if the file is not writable
+	//# or could not be extended. The $elements$ parameter must not point into the array itself.
+	//
+	//# \also	$@MappedArray::AppendArrayElement@$
+
+
+	template <typename type, typename countType = int32>
+	class MappedArray final : public MappedArrayBase, public ImmutableArray<type, countType>
+	{
+		static_assert(__is_trivially_copyable(type), "MappedArray requires a trivially copyable type");
+
+		private:
+
+			using ImmutableArray<type, countType>::elementCount;
+			using ImmutableArray<type, countType>::reservedCount;
+			using ImmutableArray<type, countType>::arrayPointer;
+
+			void UpdateArrayPointer(void);
+			bool ExtendArray(uint64 capacity);
+
+		public:
+
+			MappedArray();
+			~MappedArray();
+
+			MappedArrayResult OpenMappedArray(const char *name, uint32 flags = 0);
+			void CloseMappedArray(void);
+
+			void FlushMappedArray(void)
+			{
+				FlushMappedFile();
+			}
+
+			bool ReserveArrayElementCount(countType count);
+			bool SetArrayElementCount(countType count);
+			type *AppendArrayElement(const type& element);
+			type *AppendArrayElements(const type *elements, countType count);
+	};
+
+
+	template <typename type, typename countType>
+	MappedArray<type, countType>::MappedArray()
+	{
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+	}
+
+	template <typename type, typename countType>
+	MappedArray<type, countType>::~MappedArray()
+	{
+		CloseMappedFile();
+	}
+
+	template <typename type, typename countType>
+	void MappedArray<type, countType>::UpdateArrayPointer(void)
+	{
+		arrayPointer = reinterpret_cast<type *>(GetMappedData());
+
+		// The reserved count is clamped so that it never exceeds what countType can index.
+
+		uint64 capacity = GetMappedCapacity();
+		uint64 maxCount = ~uint64(0) >> (65 - sizeof(countType) * 8);
+		reservedCount = countType((capacity < maxCount) ? capacity : maxCount);
+	}
+
+	template <typename type, typename countType>
+	MappedArrayResult MappedArray<type, countType>::OpenMappedArray(const char *name, uint32 flags)
+	{
+		CloseMappedArray();
+
+		MappedArrayResult result = OpenMappedFile(name, flags, sizeof(type));
+		if (result == kMappedArrayOkay)
+		{
+			UpdateArrayPointer();
+
+			uint64 count = GetMappedHeader()->elementCount;
+			if (count > uint64(reservedCount))
+			{
+				CloseMappedFile();
+				arrayPointer = nullptr;
+				reservedCount = 0;
+				return (kMappedArrayFormatInvalid);
+			}
+
+			elementCount = countType(count);
+		}
+
+		return (result);
+	}
+
+	template <typename type, typename countType>
+	void MappedArray<type, countType>::CloseMappedArray(void)
+	{
+		CloseMappedFile();
+
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+	}
+
+	template <typename type, typename countType>
+	bool MappedArray<type, countType>::ExtendArray(uint64 capacity)
+	{
+		if (ExtendMappedFile(capacity))
+		{
+			UpdateArrayPointer();
+			return (true);
+		}
+
+		if (!IsMappedArrayOpen())
+		{
+			// The file could not even be mapped again at its old size, so it has been closed.
+
+			elementCount = 0;
+			reservedCount = 0;
+			arrayPointer = nullptr;
+		}
+
+		return (false);
+	}
+
+	template <typename type, typename countType>
+	bool MappedArray<type, countType>::ReserveArrayElementCount(countType count)
+	{
+		if ((!IsMappedArrayWritable()) || (count < 0))
+		{
+			return (false);
+		}
+
+		return ((count <= reservedCount) || (ExtendArray(uint64(count))));
+	}
+
+	template <typename type, typename countType>
+	bool MappedArray<type, countType>::SetArrayElementCount(countType count)
+	{
+		if ((!IsMappedArrayWritable()) || (count < 0))
+		{
+			return (false);
+		}
+
+		if (count > reservedCount)
+		{
+			// The file grows by at least half its current capacity so that a sequence of
+			// appends remaps the file a logarithmic number of times.
+
+			uint64 capacity = uint64(reservedCount) + (uint64(reservedCount) >> 1);
+			if (!ExtendArray((capacity > uint64(count)) ? capacity : uint64(count)))
+			{
+				return (false);
+			}
+		}
+
+		elementCount = count;
+		GetMappedHeader()->elementCount = uint64(count);
+		return (true);
+	}
+
+	template <typename type, typename countType>
+	type *MappedArray<type, countType>::AppendArrayElement(const type& element)
+	{
+		return (AppendArrayElements(&element, 1));
+	}
+
+	template <typename type, typename countType>
+	type *MappedArray<type, countType>::AppendArrayElements(const type *elements, countType count)
+	{
+		countType index = elementCount;
+		if (!SetArrayElementCount(index + count))
+		{
+			return (nullptr);
+		}
+
+		type *pointer = arrayPointer + index;
+		CopyMemory(elements, pointer, sizeof(type) * count);
+		return (pointer);
+	}
+}
+
+
+#endif
@@ -0,0 +1,673 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#include "TSPackedArray.h"
+
+
+using namespace Terathon;
+
+
+// Each row of this table is the byte shuffle that expands one group of four variable-length
+// values into four 32-bit values. The row index is the control byte for the group, and the
+// entries equal to 0xFF produce zero bytes with both the SSSE3 and NEON table instructions.
+
+alignas(16) const uint8 PackedArrayCodec::varintShuffleTable[256][16] =
+{
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0x0A, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0x0B, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0x0A, 0x0B, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0x0B, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0x0B, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0x0B, 0x0C, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0x0A, 0x0B, 0x0C, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0x0B, 0x0C, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0x0B, 0x0C, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0x0B, 0x0C, 0x0D, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0x0A, 0x0B, 0x0C, 0x0D},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0x08},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0x0B, 0x0C, 0x0D},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0x0A, 0x0B, 0x0C, 0x0D},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0x0B, 0x0C, 0x0D, 0x0E},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E},
+	{0x00, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0x01, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D},
+	{0x00, 0x01, 0x02, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F}
+
+};
+
+
+// Each row of this table is the byte shuffle that expands one pair of variable-length values
+// into two 64-bit values. The row index holds the 3-bit length codes of both values, which is
+// calculated from the control byte by the GetVarintPairIndex() function.
+
+alignas(16) const uint8 PackedArrayCodec::varint64ShuffleTable[64][16] =
+{
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0xFF, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFF},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xFF},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0xFF},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0xFF},
+	{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08},
+	{0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09},
+	{0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A},
+	{0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xFF, 0xFF, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F}
+};
+
+
+void PackedArrayCodec::PackBits(const uint32 *input, machine count, int32 width, uint8 *output)
+{
+	// The output buffer must be cleared beforehand, and it must have at least
+	// eight bytes of padding because each value is merged into a 64-bit word.
+
+	uint64 bitOffset = 0;
+	for (machine a = 0; a < count; a++)
+	{
+		uint8 *data = output + (bitOffset >> 3);
+		uint64 word = LoadPackedWord(data) | (uint64(input[a]) << (bitOffset & 7));
+		CopyMemory(&word, data, 8);
+		bitOffset += width;
+	}
+}
+
+void PackedArrayCodec::PackBits(const uint64 *input, machine count, int32 width, uint8 *output)
+{
+	// A 64-bit value that begins partway into a byte spills into the ninth byte, so the
+	// output buffer must have at least sixteen bytes of padding in this case.
+
+	uint64 bitOffset = 0;
+	for (machine a = 0; a < count; a++)
+	{
+		uint8 *data = output + (bitOffset >> 3);
+		int32 shift = int32(bitOffset & 7);
+
+		uint64 value = input[a];
+		uint64 word = LoadPackedWord(data) | (value << shift);
+		CopyMemory(&word, data, 8);
+
+		if (shift != 0)
+		{
+			data[8] |= uint8(value >> (64 - shift));
+		}
+
+		bitOffset += width;
+	}
+}
+
+void PackedArrayCodec::UnpackBits(const uint8 *data, uint64 bitOffset, int32 width, machine count, uint32 *output)
+{
+	if (width == 0)
+	{
+		FillMemory(output, count * sizeof(uint32), 0);
+		return;
+	}
+
+	machine a = 0;
+	uint64 mask = (uint64(1) << width) - 1;
+
+	#if TERATHON_AVX2
+
+		// Four values are fetched at once with a gather instruction. Every value begins less than
+		// eight bits into the 64-bit word loaded for it, so a value of up to 32 bits always fits.
+		// Without a gather instruction, the scalar loop below is as fast as a vector version.
+
+		const __m256i maskVector = _mm256_set1_epi64x(int64(mask));
+		const __m256i shiftMask = _mm256_set1_epi64x(7);
+		const __m256i permute = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+		const __m256i step = _mm256_set1_epi64x(int64(width) * 4);
+
+		__m256i position = _mm256_setr_epi64x(int64(bitOffset), int64(bitOffset + width), int64(bitOffset + width * 2), int64(bitOffset + width * 3));
+		for (; a + 4 <= count; a += 4)
+		{
+			__m256i word = _mm256_i64gather_epi64(reinterpret_cast<const long long *>(data), _mm256_srli_epi64(position, 3), 1);
+			word = _mm256_and_si256(_mm256_srlv_epi64(word, _mm256_and_si256(position, shiftMask)), maskVector);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output + a), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(word, permute)));
+			position = _mm256_add_epi64(position, step);
+		}
+
+		bitOffset += uint64(a) * width;
+
+	#endif
+
+	for (; a < count; a++)
+	{
+		uint64 word = LoadPackedWord(data + (bitOffset >> 3));
+		output[a] = uint32((word >> (bitOffset & 7)) & mask);
+		bitOffset += width;
+	}
+}
+
+void PackedArrayCodec::UnpackBits(const uint8 *data, uint64 bitOffset, int32 width, machine count, uint64 *output)
+{
+	if (width == 0)
+	{
+		FillMemory(output, count * sizeof(uint64), 0);
+		return;
+	}
+
+	machine a = 0;
+
+	#if TERATHON_AVX2
+
+		// The gather used for 32-bit values also works for 64-bit values as long as every value
+		// fits in the 64-bit word loaded for it after being shifted by up to seven bits.
+
+		if (width <= 57)
+		{
+			const __m256i maskVector = _mm256_set1_epi64x(int64(~uint64(0) >> (64 - width)));
+			const __m256i shiftMask = _mm256_set1_epi64x(7);
+			const __m256i step = _mm256_set1_epi64x(int64(width) * 4);
+
+			__m256i position = _mm256_setr_epi64x(int64(bitOffset), int64(bitOffset + width), int64(bitOffset + width * 2), int64(bitOffset + width * 3));
+			for (; a + 4 <= count; a += 4)
+			{
+				__m256i word = _mm256_i64gather_epi64(reinterpret_cast<const long long *>(data), _mm256_srli_epi64(position, 3), 1);
+				word = _mm256_and_si256(_mm256_srlv_epi64(word, _mm256_and_si256(position, shiftMask)), maskVector);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(output + a), word);
+				position = _mm256_add_epi64(position, step);
+			}
+
+			bitOffset += uint64(a) * width;
+		}
+
+	#endif
+
+	for (; a < count; a++)
+	{
+		output[a] = UnpackValue64(data, bitOffset, width);
+		bitOffset += width;
+	}
+}
+
+void PackedArrayCodec::AddPrefixSum(uint32 *data, machine count, uint32 base)
+{
+	machine a = 0;
+
+	#if TERATHON_SSE2
+
+		// The running sum of four values is calculated in a register with two shifted adds,
+		// and the last sum is broadcast to all four lanes to be carried into the next group.
+
+		__m128i sum = _mm_set1_epi32(int32(base));
+		for (; a + 4 <= count; a += 4)
+		{
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + a));
+			x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+			x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+			x = _mm_add_epi32(x, sum);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(data + a), x);
+			sum = _mm_shuffle_epi32(x, 0xFF);
+		}
+
+		base = uint32(_mm_cvtsi128_si32(sum));
+
+	#elif TERATHON_NEON
+
+		const uint32x4_t zero = vdupq_n_u32(0);
+
+		uint32x4_t sum = vdupq_n_u32(base);
+		for (; a + 4 <= count; a += 4)
+		{
+			uint32x4_t x = vld1q_u32(data + a);
+			x = vaddq_u32(x, vextq_u32(zero, x, 3));
+			x = vaddq_u32(x, vextq_u32(zero, x, 2));
+			x = vaddq_u32(x, sum);
+			vst1q_u32(data + a, x);
+			sum = vdupq_n_u32(vgetq_lane_u32(x, 3));
+		}
+
+		base = vgetq_lane_u32(sum, 0);
+
+	#endif
+
+	for (; a < count; a++)
+	{
+		base += data[a];
+		data[a] = base;
+	}
+}
+
+void PackedArrayCodec::AddPrefixSum(uint64 *data, machine count, uint64 base)
+{
+	machine a = 0;
+
+	#if TERATHON_SSE2
+
+		__m128i sum = _mm_set1_epi64x(int64(base));
+		for (; a + 2 <= count; a += 2)
+		{
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + a));
+			x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+			x = _mm_add_epi64(x, sum);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(data + a), x);
+			sum = _mm_unpackhi_epi64(x, x);
+		}
+
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(&base), sum);
+
+	#elif TERATHON_NEON
+
+		// The data is accessed as bytes because uint64 and uint64_t are not the same type on every platform.
+
+		const uint64x2_t zero = vdupq_n_u64(0);
+
+		uint64x2_t sum = vdupq_n_u64(base);
+		for (; a + 2 <= count; a += 2)
+		{
+			uint64x2_t x = vreinterpretq_u64_u8(vld1q_u8(reinterpret_cast<const uint8 *>(data + a)));
+			x = vaddq_u64(x, vextq_u64(zero, x, 1));
+			x = vaddq_u64(x, sum);
+			vst1q_u8(reinterpret_cast<uint8 *>(data + a), vreinterpretq_u8_u64(x));
+			sum = vdupq_n_u64(vgetq_lane_u64(x, 1));
+		}
+
+		base = vgetq_lane_u64(sum, 0);
+
+	#endif
+
+	for (; a < count; a++)
+	{
+		base += data[a];
+		data[a] = base;
+	}
+}
+
+const uint8 *PackedArrayCodec::DecodeVarints(const uint8 *control, const uint8 *data, machine count, uint32 *output)
+{
+	// The data must be followed by at least 16 bytes of padding because every group of
+	// four values is loaded with a single 16-byte read regardless of its actual size.
+
+	machine a = 0;
+
+	#if TERATHON_AVX2
+
+		for (; a + 4 <= count; a += 4)
+		{
+			uint32 code = *control++;
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+			x = _mm_shuffle_epi8(x, _mm_load_si128(reinterpret_cast<const __m128i *>(varintShuffleTable[code])));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output + a), x);
+			data += GetVarintGroupSize(code);
+		}
+
+	#elif TERATHON_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+
+		for (; a + 4 <= count; a += 4)
+		{
+			uint32 code = *control++;
+			uint8x16_t x = vqtbl1q_u8(vld1q_u8(data), vld1q_u8(varintShuffleTable[code]));
+			vst1q_u32(output + a, vreinterpretq_u32_u8(x));
+			data += GetVarintGroupSize(code);
+		}
+
+	#endif
+
+	for (; a < count; a += 4)
+	{
+		uint32 code = *control++;
+
+		machine groupCount = Min(int32(count - a), 4);
+		for (machine b = 0; b < groupCount; b++)
+		{
+			uint32		value;
+
+			int32 size = int32(code & 3) + 1;
+			CopyMemory(data, &value, 4);
+			output[a + b] = value & (0xFFFFFFFFU >> ((4 - size) * 8));
+
+			data += size;
+			code >>= 2;
+		}
+	}
+
+	return (data);
+}
+
+const uint8 *PackedArrayCodec::DecodeVarints(const uint8 *control, const uint8 *data, machine count, uint64 *output)
+{
+	// Each control byte describes a pair of values that occupies at most 16 bytes, so the same
+	// 16 bytes of padding required for 32-bit values allow each pair to be loaded with one read.
+
+	machine a = 0;
+
+	#if TERATHON_AVX2
+
+		for (; a + 2 <= count; a += 2)
+		{
+			uint32 code = *control++;
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+			x = _mm_shuffle_epi8(x, _mm_load_si128(reinterpret_cast<const __m128i *>(varint64ShuffleTable[GetVarintPairIndex(code)])));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output + a), x);
+			data += GetVarintPairSize(code);
+		}
+
+	#elif TERATHON_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+
+		for (; a + 2 <= count; a += 2)
+		{
+			uint32 code = *control++;
+			uint8x16_t x = vqtbl1q_u8(vld1q_u8(data), vld1q_u8(varint64ShuffleTable[GetVarintPairIndex(code)]));
+			vst1q_u8(reinterpret_cast<uint8 *>(output + a), x);
+			data += GetVarintPairSize(code);
+		}
+
+	#endif
+
+	for (; a < count; a += 2)
+	{
+		uint32 code = *control++;
+
+		machine pairCount = Min(int32(count - a), 2);
+		for (machine b = 0; b < pairCount; b++)
+		{
+			uint64		value;
+
+			int32 size = int32(code & 7) + 1;
+			CopyMemory(data, &value, 8);
+			output[a + b] = value & (~uint64(0) >> ((8 - size) * 8));
+
+			data += size;
+			code >>= 4;
+		}
+	}
+
+	return (data);
+}
+
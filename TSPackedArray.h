@@ -0,0 +1,956 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSPackedArray_h
+#define TSPackedArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_PACKEDARRAY 1
+
+
+namespace Terathon
+{
+	enum
+	{
+		kPackedArrayBlockShift		= 7,
+		kPackedArrayBlockSize		= 1 << kPackedArrayBlockShift,
+		kPackedArrayBlockMask		= kPackedArrayBlockSize - 1
+	};
+
+
+	class PackedArrayCodec
+	{
+		private:
+
+			alignas(16) static const uint8 varintShuffleTable[256][16];
+			alignas(16) static const uint8 varint64ShuffleTable[64][16];
+
+			static uint32 GetVarintPairIndex(uint32 control)
+			{
+				return ((control & 7) | ((control >> 1) & 0x38));
+			}
+
+		public:
+
+			static int32 GetBitWidth(uint32 value)
+			{
+				return (32 - Cntlz(value));
+			}
+
+			static int32 GetBitWidth(uint64 value)
+			{
+				uint32 high = uint32(value >> 32);
+				return ((high != 0) ? 64 - Cntlz(high) : 32 - Cntlz(uint32(value)));
+			}
+
+			static uint64 LoadPackedWord(const uint8 *data)
+			{
+				uint64		word;
+
+				CopyMemory(data, &word, 8);
+				return (word);
+			}
+
+			static uint32 UnpackValue(const uint8 *data, uint64 bitOffset, int32 width)
+			{
+				uint64 word = LoadPackedWord(data + (bitOffset >> 3));
+				return (uint32((word >> (bitOffset & 7)) & ((uint64(1) << width) - 1)));
+			}
+
+			static uint64 UnpackValue64(const uint8 *data, uint64 bitOffset, int32 width)
+			{
+				// A 64-bit value can extend up to seven bits into the byte following the word loaded for it.
+
+				data += bitOffset >> 3;
+				int32 shift = int32(bitOffset & 7);
+				uint64 value = LoadPackedWord(data) >> shift;
+				if (shift != 0)
+				{
+					value |= uint64(data[8]) << (64 - shift);
+				}
+
+				return ((width != 0) ? value & (~uint64(0) >> (64 - width)) : 0);
+			}
+
+			static int32 GetVarintSize(uint32 value)
+			{
+				return ((value < 0x0100U) ? 1 : ((value < 0x010000U) ? 2 : ((value < 0x01000000U) ? 3 : 4)));
+			}
+
+			static int32 GetVarintSize(uint64 value)
+			{
+				int32 width = GetBitWidth(value);
+				return ((width != 0) ? (width + 7) >> 3 : 1);
+			}
+
+			static int32 GetVarintGroupSize(uint32 control)
+			{
+				return (int32((control & 3) + ((control >> 2) & 3) + ((control >> 4) & 3) + (control >> 6)) + 4);
+			}
+
+			static int32 GetVarintPairSize(uint32 control)
+			{
+				return (int32((control & 7) + ((control >> 4) & 7)) + 2);
+			}
+
+			TERATHON_API static void PackBits(const uint32 *input, machine count, int32 width, uint8 *output);
+			TERATHON_API static void PackBits(const uint64 *input, machine count, int32 width, uint8 *output);
+			TERATHON_API static void UnpackBits(const uint8 *data, uint64 bitOffset, int32 width, machine count, uint32 *output);
+			TERATHON_API static void UnpackBits(const uint8 *data, uint64 bitOffset, int32 width, machine count, uint64 *output);
+			TERATHON_API static void AddPrefixSum(uint32 *data, machine count, uint32 base);
+			TERATHON_API static void AddPrefixSum(uint64 *data, machine count, uint64 base);
+			TERATHON_API static const uint8 *DecodeVarints(const uint8 *control, const uint8 *data, machine count, uint32 *output);
+			TERATHON_API static const uint8 *DecodeVarints(const uint8 *control, const uint8 *data, machine count, uint64 *output);
+	};
+
+
+	// The traits select the parts of the packed formats that depend on the size of the integers.
+	// Variable-length 32-bit values have 2-bit lengths, four to a control byte, and variable-length
+	// 64-bit values have 4-bit lengths, two to a control byte.
+
+	template <typename type>
+	struct PackedArrayTraits;
+
+	template <>
+	struct PackedArrayTraits<uint32>
+	{
+		enum
+		{
+			kVarintGroupShift	= 2,
+			kVarintCodeBits		= 2
+		};
+
+		static uint32 UnpackValue(const uint8 *data, uint64 bitOffset, int32 width)
+		{
+			return (PackedArrayCodec::UnpackValue(data, bitOffset, width));
+		}
+
+		static int32 GetVarintGroupSize(uint32 control)
+		{
+			return (PackedArrayCodec::GetVarintGroupSize(control));
+		}
+	};
+
+	template <>
+	struct PackedArrayTraits<uint64>
+	{
+		enum
+		{
+			kVarintGroupShift	= 1,
+			kVarintCodeBits		= 4
+		};
+
+		static uint64 UnpackValue(const uint8 *data, uint64 bitOffset, int32 width)
+		{
+			return (PackedArrayCodec::UnpackValue64(data, bitOffset, width));
+		}
+
+		static int32 GetVarintGroupSize(uint32 control)
+		{
+			return (PackedArrayCodec::GetVarintPairSize(control));
+		}
+	};
+
+
+	//# \class	BitPackedArray		A read-only array of integers stored with a fixed number of bits each.
+	//
+	//# The $BitPackedArray$ class stores an array of unsigned integers using the smallest number of bits
+	//# that can represent the largest of them.
+	//
+	//# \def	template <typename type = uint32> class BitPackedArray
+	//
+	//# \tparam	type	The type of integer stored in the array. This must be $uint32$ or $uint64$.
+	//
+	//# \ctor	BitPackedArray();
+	//# \ctor	explicit BitPackedArray(const ImmutableArray<type>& array);
+	//
+	//# \param	array	An array whose contents are packed into the new object.
+	//
+	//# \desc
+	//# The $BitPackedArray$ class packs integers end to end using the same number of bits for every value, which is the
+	//# number of bits needed to represent the largest value in the array. Any element can be retrieved in constant time
+	//# with the $[]$ operator, but elements cannot be modified individually. The contents are replaced as a whole by
+	//# calling the $@BitPackedArray::BuildArray@$ function.
+	//#
+	//# This format is best suited for values that are distributed over a small range beginning at zero. Sorted values
+	//# are usually stored much more compactly by the $@BlockPackedArray@$ class. When AVX2 is available, ranges of
+	//# elements are decoded four at a time with gather instructions. For 64-bit integers, this applies to bit widths
+	//# up to 57, and wider values are decoded one at a time.
+	//
+	//# \also	$@BlockPackedArray@$
+	//# \also	$@VarintPackedArray@$
+
+
+	//# \function	BitPackedArray::BuildArray		Packs an array of integers.
+	//
+	//# \proto	void BuildArray(const type *values, int32 count);
+	//
+	//# \param	values	A pointer to the integers to pack.
+	//# \param	count	The number of integers to pack.
+	//
+	//# \desc
+	//# The $BuildArray$ function replaces the contents of a packed array with the $count$ integers specified by the
+	//# $values$ parameter. The bit width is chosen so that the largest of the values can be represented.
+	//
+	//# \also	$@BitPackedArray::DecodeArrayElements@$
+
+
+	//# \function	BitPackedArray::DecodeArrayElements		Decodes a range of elements of a packed array.
+	//
+	//# \proto	void DecodeArrayElements(int32 start, int32 count, type *output) const;
+	//
+	//# \param	start	The index of the first element to decode.
+	//# \param	count	The number of elements to decode.
+	//# \param	output	A pointer to a buffer that receives the decoded elements.
+	//
+	//# \desc
+	//# The $DecodeArrayElements$ function unpacks the $count$ elements beginning at index $start$ and stores them in the
+	//# buffer specified by the $output$ parameter. The range must lie entirely inside the array.
+	//
+	//# \also	$@BitPackedArray::DecodeArray@$
+	//# \also	$@BitPackedArray::DecodeArrayBlocks@$
+
+
+	//# \function	BitPackedArray::DecodeArray		Decodes the entire contents of a packed array.
+	//
+	//# \proto	template <int32 baseCount, class allocatorType> void DecodeArray(Array<type, baseCount, allocatorType>& array) const;
+	//
+	//# \param	array	The array that receives the decoded elements.
+	//
+	//# \desc
+	//# The $DecodeArray$ function sets the size of the array specified by the $array$ parameter to the number of elements
+	//# in a packed array and stores all of the decoded elements in it. Any previous contents of $array$ are overwritten.
+	//
+	//# \also	$@BitPackedArray::DecodeArrayElements@$
+	//# \also	$@BitPackedArray::DecodeArrayBlocks@$
+
+
+	//# \function	BitPackedArray::DecodeArrayBlocks		Decodes a packed array in blocks and passes them to a callback function.
+	//
+	//# \proto	template <typename callbackType> void DecodeArrayBlocks(callbackType&& callback) const;
+	//
+	//# \param	callback	A function object that is called for each block of decoded elements.
+	//
+	//# \desc
+	//# The $DecodeArrayBlocks$ function decodes a packed array in blocks of 128 elements (except possibly the last block)
+	//# and calls the function specified by the $callback$ parameter once for each block, in order. The callback is called
+	//# with the parameters $(const type *values, int32 start, int32 count)$, where $start$ is the index of the first
+	//# element in the block, and $count$ is the number of elements in the block. The values are stored in a temporary
+	//# buffer that is reused for the next block, so the whole array is never decoded at once.
+	//
+	//# \also	$@BitPackedArray::DecodeArrayElements@$
+	//# \also	$@BitPackedArray::DecodeArray@$
+
+
+	template <typename type = uint32>
+	class BitPackedArray
+	{
+		private:
+
+			int32				elementCount;
+			int32				bitWidth;
+
+			LargeArray<uint8>	packedData;
+
+		public:
+
+			BitPackedArray();
+			explicit BitPackedArray(const ImmutableArray<type>& array);
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (elementCount);
+			}
+
+			int32 GetArrayBlockCount(void) const
+			{
+				return ((elementCount + kPackedArrayBlockMask) >> kPackedArrayBlockShift);
+			}
+
+			int32 GetBitWidth(void) const
+			{
+				return (bitWidth);
+			}
+
+			umachine GetPackedSize(void) const
+			{
+				return (umachine(packedData.GetArrayElementCount()));
+			}
+
+			type operator [](machine index) const
+			{
+				return (PackedArrayTraits<type>::UnpackValue(packedData, uint64(index) * bitWidth, bitWidth));
+			}
+
+			template <int32 baseCount, class allocatorType>
+			void DecodeArray(Array<type, baseCount, allocatorType>& array) const
+			{
+				array.SetArrayElementCount(elementCount);
+				DecodeArrayElements(0, elementCount, array);
+			}
+
+			template <typename callbackType>
+			void DecodeArrayBlocks(callbackType&& callback) const;
+
+			void BuildArray(const type *values, int32 count);
+			void PurgeArray(void);
+
+			void DecodeArrayElements(int32 start, int32 count, type *output) const;
+			int32 DecodeArrayBlock(int32 blockIndex, type *output) const;
+	};
+
+	template <typename type>
+	BitPackedArray<type>::BitPackedArray()
+	{
+		elementCount = 0;
+		bitWidth = 0;
+	}
+
+	template <typename type>
+	BitPackedArray<type>::BitPackedArray(const ImmutableArray<type>& array)
+	{
+		elementCount = 0;
+		bitWidth = 0;
+		BuildArray(array, array.GetArrayElementCount());
+	}
+
+	template <typename type>
+	void BitPackedArray<type>::BuildArray(const type *values, int32 count)
+	{
+		type maxValue = 0;
+		for (machine a = 0; a < count; a++)
+		{
+			maxValue |= values[a];
+		}
+
+		// The 16 bytes of padding cover the 64-bit word loaded for the last value
+		// and the extra byte that a 64-bit value can spill into.
+
+		int32 width = PackedArrayCodec::GetBitWidth(maxValue);
+		int64 size = ((int64(count) * width + 7) >> 3) + 16;
+
+		packedData.SetArrayElementCount(size);
+		FillMemory(packedData, umachine(size), 0);
+		PackedArrayCodec::PackBits(values, count, width, packedData);
+
+		elementCount = count;
+		bitWidth = width;
+	}
+
+	template <typename type>
+	void BitPackedArray<type>::PurgeArray(void)
+	{
+		packedData.PurgeArray();
+		elementCount = 0;
+		bitWidth = 0;
+	}
+
+	template <typename type>
+	void BitPackedArray<type>::DecodeArrayElements(int32 start, int32 count, type *output) const
+	{
+		if (count > 0)
+		{
+			PackedArrayCodec::UnpackBits(packedData, uint64(start) * bitWidth, bitWidth, count, output);
+		}
+	}
+
+	template <typename type>
+	int32 BitPackedArray<type>::DecodeArrayBlock(int32 blockIndex, type *output) const
+	{
+		int32 start = blockIndex << kPackedArrayBlockShift;
+		int32 count = Min(elementCount - start, kPackedArrayBlockSize);
+		DecodeArrayElements(start, count, output);
+		return (count);
+	}
+
+	template <typename type>
+	template <typename callbackType>
+	void BitPackedArray<type>::DecodeArrayBlocks(callbackType&& callback) const
+	{
+		type		buffer[kPackedArrayBlockSize];
+
+		int32 blockCount = GetArrayBlockCount();
+		for (machine a = 0; a < blockCount; a++)
+		{
+			int32 count = DecodeArrayBlock(int32(a), buffer);
+			callback(static_cast<const type *>(buffer), int32(a << kPackedArrayBlockShift), count);
+		}
+	}
+
+
+	//# \class	BlockPackedArray		A read-only array of integers compressed in blocks of 128 elements.
+	//
+	//# The $BlockPackedArray$ class stores an array of unsigned integers using frame-of-reference or delta
+	//# coding in blocks of 128 elements.
+	//
+	//# \def	template <typename type = uint32> class BlockPackedArray
+	//
+	//# \tparam	type	The type of integer stored in the array. This must be $uint32$ or $uint64$.
+	//
+	//# \ctor	BlockPackedArray();
+	//# \ctor	explicit BlockPackedArray(const ImmutableArray<type>& array);
+	//
+	//# \param	array	An array whose contents are packed into the new object.
+	//
+	//# \desc
+	//# The $BlockPackedArray$ class divides an array of integers into blocks of 128 elements and packs each block with
+	//# its own bit width. If the values in the array never decrease, as in a sorted list of identifiers, then each block
+	//# stores its first value followed by the differences between consecutive values. Otherwise, each block stores its
+	//# smallest value followed by the offsets of all of its values from the smallest one. In both cases, a block of
+	//# closely spaced values needs only a few bits per element.
+	//#
+	//# With frame-of-reference coding, any element can be retrieved in constant time with the $[]$ operator. With delta
+	//# coding, retrieving an element requires the differences preceding it in its block to be summed. Decoding a whole
+	//# block uses vector instructions to compute the running sum four 32-bit elements or two 64-bit elements at a time.
+	//#
+	//# The decoding functions have the same interface as those in the $@BitPackedArray@$ class.
+	//
+	//# \also	$@BitPackedArray@$
+	//# \also	$@VarintPackedArray@$
+
+
+	template <typename type = uint32>
+	class BlockPackedArray
+	{
+		private:
+
+			struct PackedBlock
+			{
+				type		blockBase;
+				uint32		blockOffset;
+			};
+
+			int32				elementCount;
+			bool				deltaFlag;
+
+			Array<PackedBlock>	blockArray;
+			LargeArray<uint8>	packedData;
+
+			void CalculateBlockValues(const type *values, int32 count, type *output, type *base) const;
+
+		public:
+
+			BlockPackedArray();
+			explicit BlockPackedArray(const ImmutableArray<type>& array);
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (elementCount);
+			}
+
+			int32 GetArrayBlockCount(void) const
+			{
+				return ((elementCount + kPackedArrayBlockMask) >> kPackedArrayBlockShift);
+			}
+
+			bool GetDeltaFlag(void) const
+			{
+				return (deltaFlag);
+			}
+
+			umachine GetPackedSize(void) const
+			{
+				return (umachine(packedData.GetArrayElementCount()) + blockArray.GetArrayElementCount() * sizeof(PackedBlock));
+			}
+
+			type operator [](machine index) const
+			{
+				return (GetArrayElement(int32(index)));
+			}
+
+			template <int32 baseCount, class allocatorType>
+			void DecodeArray(Array<type, baseCount, allocatorType>& array) const
+			{
+				array.SetArrayElementCount(elementCount);
+				DecodeArrayElements(0, elementCount, array);
+			}
+
+			template <typename callbackType>
+			void DecodeArrayBlocks(callbackType&& callback) const;
+
+			void BuildArray(const type *values, int32 count);
+			void PurgeArray(void);
+
+			type GetArrayElement(int32 index) const;
+			void DecodeArrayElements(int32 start, int32 count, type *output) const;
+			int32 DecodeArrayBlock(int32 blockIndex, type *output) const;
+	};
+
+	template <typename type>
+	BlockPackedArray<type>::BlockPackedArray()
+	{
+		elementCount = 0;
+		deltaFlag = false;
+	}
+
+	template <typename type>
+	BlockPackedArray<type>::BlockPackedArray(const ImmutableArray<type>& array)
+	{
+		elementCount = 0;
+		deltaFlag = false;
+		BuildArray(array, array.GetArrayElementCount());
+	}
+
+	template <typename type>
+	void BlockPackedArray<type>::CalculateBlockValues(const type *values, int32 count, type *output, type *base) const
+	{
+		// The values for a block are always padded with zeros to the full block size so that every
+		// block occupies exactly 16 bytes for each bit of its width.
+
+		if (deltaFlag)
+		{
+			type previous = values[0];
+			*base = previous;
+
+			for (machine a = 0; a < count; a++)
+			{
+				type value = values[a];
+				output[a] = value - previous;
+				previous = value;
+			}
+		}
+		else
+		{
+			type minValue = values[0];
+			for (machine a = 1; a < count; a++)
+			{
+				minValue = (values[a] < minValue) ? values[a] : minValue;
+			}
+
+			*base = minValue;
+
+			for (machine a = 0; a < count; a++)
+			{
+				output[a] = values[a] - minValue;
+			}
+		}
+
+		for (machine a = count; a < kPackedArrayBlockSize; a++)
+		{
+			output[a] = 0;
+		}
+	}
+
+	template <typename type>
+	void BlockPackedArray<type>::BuildArray(const type *values, int32 count)
+	{
+		type		blockValue[kPackedArrayBlockSize];
+
+		bool delta = (count > 1);
+		for (machine a = 1; a < count; a++)
+		{
+			if (values[a] < values[a - 1])
+			{
+				delta = false;
+				break;
+			}
+		}
+
+		deltaFlag = delta;
+		elementCount = count;
+
+		int32 blockCount = GetArrayBlockCount();
+		blockArray.SetArrayElementCount(blockCount + 1);
+
+		// The first pass determines the base value and bit width of each block. A block with a
+		// width of w bits occupies 16w bytes, so the offset of each block is stored in units of 16
+		// bytes, and the width of a block is the difference between its offset and the next one.
+
+		uint32 offset = 0;
+		for (machine block = 0; block < blockCount; block++)
+		{
+			int32 start = int32(block << kPackedArrayBlockShift);
+			int32 blockSize = Min(count - start, kPackedArrayBlockSize);
+
+			type base = 0;
+			CalculateBlockValues(values + start, blockSize, blockValue, &base);
+
+			type maxValue = 0;
+			for (machine a = 0; a < blockSize; a++)
+			{
+				maxValue |= blockValue[a];
+			}
+
+			blockArray[block].blockBase = base;
+			blockArray[block].blockOffset = offset;
+			offset += PackedArrayCodec::GetBitWidth(maxValue);
+		}
+
+		blockArray[blockCount].blockBase = 0;
+		blockArray[blockCount].blockOffset = offset;
+
+		int64 size = int64(offset) * 16 + 16;
+		packedData.SetArrayElementCount(size);
+		FillMemory(packedData, umachine(size), 0);
+
+		for (machine block = 0; block < blockCount; block++)
+		{
+			int32 start = int32(block << kPackedArrayBlockShift);
+			int32 blockSize = Min(count - start, kPackedArrayBlockSize);
+
+			type base = 0;
+			CalculateBlockValues(values + start, blockSize, blockValue, &base);
+
+			uint32 blockOffset = blockArray[block].blockOffset;
+			int32 width = int32(blockArray[block + 1].blockOffset - blockOffset);
+			PackedArrayCodec::PackBits(blockValue, kPackedArrayBlockSize, width, &packedData[int64(blockOffset) * 16]);
+		}
+	}
+
+	template <typename type>
+	void BlockPackedArray<type>::PurgeArray(void)
+	{
+		blockArray.PurgeArray();
+		packedData.PurgeArray();
+		elementCount = 0;
+		deltaFlag = false;
+	}
+
+	template <typename type>
+	type BlockPackedArray<type>::GetArrayElement(int32 index) const
+	{
+		const PackedBlock *block = &blockArray[index >> kPackedArrayBlockShift];
+		int32 width = int32(block[1].blockOffset - block->blockOffset);
+		const uint8 *data = &packedData[int64(block->blockOffset) * 16];
+
+		int32 position = index & kPackedArrayBlockMask;
+		if (!deltaFlag)
+		{
+			return (block->blockBase + PackedArrayTraits<type>::UnpackValue(data, uint64(position) * width, width));
+		}
+
+		type value = block->blockBase;
+		if (width != 0)
+		{
+			uint64 bitOffset = width;
+			for (machine a = 1; a <= position; a++)
+			{
+				value += PackedArrayTraits<type>::UnpackValue(data, bitOffset, width);
+				bitOffset += width;
+			}
+		}
+
+		return (value);
+	}
+
+	template <typename type>
+	void BlockPackedArray<type>::DecodeArrayElements(int32 start, int32 count, type *output) const
+	{
+		type		blockValue[kPackedArrayBlockSize];
+
+		while (count > 0)
+		{
+			int32 position = start & kPackedArrayBlockMask;
+			if ((position == 0) && (count >= Min(elementCount - start, kPackedArrayBlockSize)))
+			{
+				int32 blockSize = DecodeArrayBlock(start >> kPackedArrayBlockShift, output);
+				start += blockSize;
+				output += blockSize;
+				count -= blockSize;
+			}
+			else
+			{
+				int32 blockSize = DecodeArrayBlock(start >> kPackedArrayBlockShift, blockValue);
+				int32 size = Min(blockSize - position, count);
+				CopyMemory(blockValue + position, output, size * sizeof(type));
+				start += size;
+				output += size;
+				count -= size;
+			}
+		}
+	}
+
+	template <typename type>
+	int32 BlockPackedArray<type>::DecodeArrayBlock(int32 blockIndex, type *output) const
+	{
+		int32 start = blockIndex << kPackedArrayBlockShift;
+		int32 count = Min(elementCount - start, kPackedArrayBlockSize);
+
+		const PackedBlock *block = &blockArray[blockIndex];
+		int32 width = int32(block[1].blockOffset - block->blockOffset);
+		PackedArrayCodec::UnpackBits(&packedData[int64(block->blockOffset) * 16], 0, width, count, output);
+
+		type base = block->blockBase;
+		if (deltaFlag)
+		{
+			PackedArrayCodec::AddPrefixSum(output, count, base);
+		}
+		else
+		{
+			for (machine a = 0; a < count; a++)
+			{
+				output[a] += base;
+			}
+		}
+
+		return (count);
+	}
+
+	template <typename type>
+	template <typename callbackType>
+	void BlockPackedArray<type>::DecodeArrayBlocks(callbackType&& callback) const
+	{
+		type		buffer[kPackedArrayBlockSize];
+
+		int32 blockCount = GetArrayBlockCount();
+		for (machine a = 0; a < blockCount; a++)
+		{
+			int32 count = DecodeArrayBlock(int32(a), buffer);
+			callback(static_cast<const type *>(buffer), int32(a << kPackedArrayBlockShift), count);
+		}
+	}
+
+
+	//# \class	VarintPackedArray		A read-only array of integers stored with a variable number of bytes each.
+	//
+	//# The $VarintPackedArray$ class stores an array of unsigned integers using a variable number of bytes each.
+	//
+	//# \def	template <typename type = uint32> class VarintPackedArray
+	//
+	//# \tparam	type	The type of integer stored in the array. This must be $uint32$ or $uint64$.
+	//
+	//# \ctor	VarintPackedArray();
+	//# \ctor	explicit VarintPackedArray(const ImmutableArray<type>& array);
+	//
+	//# \param	array	An array whose contents are packed into the new object.
+	//
+	//# \desc
+	//# The $VarintPackedArray$ class stores each integer in the smallest number of whole bytes that can represent it.
+	//# The lengths are kept in a separate stream of control bytes so that the lengths of a group of values are known
+	//# before any of the values are read. For 32-bit integers, each control byte holds four 2-bit lengths between one
+	//# and four bytes, and for 64-bit integers, each control byte holds two 4-bit lengths between one and eight bytes.
+	//# This lets each group of values be decoded with a single byte shuffle instruction when SSSE3 (as part of AVX2) or
+	//# 64-bit NEON is available.
+	//#
+	//# This format handles values of widely varying magnitude better than the $@BitPackedArray@$ class, which must use
+	//# the width of the largest value for every element. The position of the first element of every block of 128 elements
+	//# is recorded, so an element is retrieved by the $[]$ operator after reading at most 32 control bytes for 32-bit
+	//# integers or 64 control bytes for 64-bit integers.
+	//#
+	//# The decoding functions have the same interface as those in the $@BitPackedArray@$ class.
+	//
+	//# \also	$@BitPackedArray@$
+	//# \also	$@BlockPackedArray@$
+
+
+	template <typename type = uint32>
+	class VarintPackedArray
+	{
+		private:
+
+			enum
+			{
+				kVarintGroupShift	= PackedArrayTraits<type>::kVarintGroupShift,
+				kVarintGroupMask	= (1 << kVarintGroupShift) - 1,
+				kVarintCodeBits		= PackedArrayTraits<type>::kVarintCodeBits,
+				kVarintCodeMask		= (1 << kVarintCodeBits) - 1
+			};
+
+			int32				elementCount;
+
+			Array<uint64>		blockOffset;
+			LargeArray<uint8>	controlData;
+			LargeArray<uint8>	varintData;
+
+		public:
+
+			VarintPackedArray();
+			explicit VarintPackedArray(const ImmutableArray<type>& array);
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (elementCount);
+			}
+
+			int32 GetArrayBlockCount(void) const
+			{
+				return ((elementCount + kPackedArrayBlockMask) >> kPackedArrayBlockShift);
+			}
+
+			umachine GetPackedSize(void) const
+			{
+				return (umachine(controlData.GetArrayElementCount() + varintData.GetArrayElementCount()) + blockOffset.GetArrayElementCount() * sizeof(uint64));
+			}
+
+			type operator [](machine index) const
+			{
+				return (GetArrayElement(int32(index)));
+			}
+
+			template <int32 baseCount, class allocatorType>
+			void DecodeArray(Array<type, baseCount, allocatorType>& array) const
+			{
+				array.SetArrayElementCount(elementCount);
+				DecodeArrayElements(0, elementCount, array);
+			}
+
+			template <typename callbackType>
+			void DecodeArrayBlocks(callbackType&& callback) const;
+
+			void BuildArray(const type *values, int32 count);
+			void PurgeArray(void);
+
+			type GetArrayElement(int32 index) const;
+			void DecodeArrayElements(int32 start, int32 count, type *output) const;
+			int32 DecodeArrayBlock(int32 blockIndex, type *output) const;
+	};
+
+	template <typename type>
+	VarintPackedArray<type>::VarintPackedArray()
+	{
+		elementCount = 0;
+	}
+
+	template <typename type>
+	VarintPackedArray<type>::VarintPackedArray(const ImmutableArray<type>& array)
+	{
+		elementCount = 0;
+		BuildArray(array, array.GetArrayElementCount());
+	}
+
+	template <typename type>
+	void VarintPackedArray<type>::BuildArray(const type *values, int32 count)
+	{
+		int64 controlSize = (int64(count) + kVarintGroupMask) >> kVarintGroupShift;
+		controlData.SetArrayElementCount(controlSize);
+		if (controlSize != 0)
+		{
+			FillMemory(controlData, umachine(controlSize), 0);
+		}
+
+		// The data is sized for the worst case first and trimmed afterward. The 16 bytes of
+		// padding at the end allow every group of values to be loaded with one vector read.
+
+		int64 dataSize = int64(count) * sizeof(type) + 16;
+		varintData.SetArrayElementCount(dataSize);
+
+		elementCount = count;
+		blockOffset.SetArrayElementCount(GetArrayBlockCount());
+
+		uint8 *control = controlData;
+		uint8 *data = varintData;
+		int64 offset = 0;
+
+		for (machine a = 0; a < count; a++)
+		{
+			if ((a & kPackedArrayBlockMask) == 0)
+			{
+				blockOffset[a >> kPackedArrayBlockShift] = uint64(offset);
+			}
+
+			type value = values[a];
+			int32 size = PackedArrayCodec::GetVarintSize(value);
+			control[a >> kVarintGroupShift] |= uint8((size - 1) << ((a & kVarintGroupMask) * kVarintCodeBits));
+
+			CopyMemory(&value, data + offset, size);
+			offset += size;
+		}
+
+		FillMemory(data + offset, 16, 0);
+		varintData.SetArrayElementCount(offset + 16);
+	}
+
+	template <typename type>
+	void VarintPackedArray<type>::PurgeArray(void)
+	{
+		blockOffset.PurgeArray();
+		controlData.PurgeArray();
+		varintData.PurgeArray();
+		elementCount = 0;
+	}
+
+	template <typename type>
+	type VarintPackedArray<type>::GetArrayElement(int32 index) const
+	{
+		int32 blockIndex = index >> kPackedArrayBlockShift;
+		int32 position = index & kPackedArrayBlockMask;
+
+		const uint8 *control = &controlData[int64(blockIndex) << (kPackedArrayBlockShift - kVarintGroupShift)];
+		const uint8 *data = &varintData[int64(blockOffset[blockIndex])];
+
+		for (machine a = position >> kVarintGroupShift; a > 0; a--)
+		{
+			data += PackedArrayTraits<type>::GetVarintGroupSize(*control++);
+		}
+
+		uint32 code = *control;
+		for (machine a = position & kVarintGroupMask; a > 0; a--)
+		{
+			data += (code & kVarintCodeMask) + 1;
+			code >>= kVarintCodeBits;
+		}
+
+		type		value;
+
+		CopyMemory(data, &value, sizeof(type));
+		return (value & (~type(0) >> ((sizeof(type) - 1 - (code & kVarintCodeMask)) * 8)));
+	}
+
+	template <typename type>
+	void VarintPackedArray<type>::DecodeArrayElements(int32 start, int32 count, type *output) const
+	{
+		type		blockValue[kPackedArrayBlockSize];
+
+		while (count > 0)
+		{
+			int32 position = start & kPackedArrayBlockMask;
+			if ((position == 0) && (count >= Min(elementCount - start, kPackedArrayBlockSize)))
+			{
+				int32 blockSize = DecodeArrayBlock(start >> kPackedArrayBlockShift, output);
+				start += blockSize;
+				output += blockSize;
+				count -= blockSize;
+			}
+			else
+			{
+				int32 blockSize = DecodeArrayBlock(start >> kPackedArrayBlockShift, blockValue);
+				int32 size = Min(blockSize - position, count);
+				CopyMemory(blockValue + position, output, size * sizeof(type));
+				start += size;
+				output += size;
+				count -= size;
+			}
+		}
+	}
+
+	template <typename type>
+	int32 VarintPackedArray<type>::DecodeArrayBlock(int32 blockIndex, type *output) const
+	{
+		int32 start = blockIndex << kPackedArrayBlockShift;
+		int32 count = Min(elementCount - start, kPackedArrayBlockSize);
+
+		const uint8 *control = &controlData[int64(blockIndex) << (kPackedArrayBlockShift - kVarintGroupShift)];
+		PackedArrayCodec::DecodeVarints(control, &varintData[int64(blockOffset[blockIndex])], count, output);
+		return (count);
+	}
+
+	template <typename type>
+	template <typename callbackType>
+	void VarintPackedArray<type>::DecodeArrayBlocks(callbackType&& callback) const
+	{
+		type		buffer[kPackedArrayBlockSize];
+
+		int32 blockCount = GetArrayBlockCount();
+		for (machine a = 0; a < blockCount; a++)
+		{
+			int32 count = DecodeArrayBlock(int32(a), buffer);
+			callback(static_cast<const type *>(buffer), int32(a << kPackedArrayBlockShift), count);
+		}
+	}
+}
+
+
+#endif
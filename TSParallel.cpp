@@ -0,0 +1,340 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#include "TSParallel.h"
+#include "TSAtomic.h"
+
+#if defined(_WIN32)
+
+	#include <windows.h>
+
+#else
+
+	#include <pthread.h>
+	#include <unistd.h>
+
+#endif
+
+
+namespace Terathon
+{
+	struct WorkerPoolData
+	{
+		#if defined(_WIN32)
+
+			SRWLOCK					poolMutex;
+			CONDITION_VARIABLE		startCondition;
+			CONDITION_VARIABLE		finishCondition;
+			HANDLE					*threadHandle;
+
+		#else
+
+			pthread_mutex_t			poolMutex;
+			pthread_cond_t			startCondition;
+			pthread_cond_t			finishCondition;
+			pthread_t				*threadHandle;
+
+		#endif
+
+		int32						workerCount;
+		int32						batchGeneration;
+		int32						busyWorkerCount;
+		bool						terminateFlag;
+
+		WorkerJobProc				*jobProc;
+		void						*jobCookie;
+		int32						jobCount;
+		volatile int32				nextJobIndex;
+
+		void Lock(void);
+		void Unlock(void);
+		void WaitStart(void);
+		void WaitFinish(void);
+
+		void RunJobs(void);
+		void WorkerLoop(void);
+	};
+}
+
+
+using namespace Terathon;
+
+
+#if defined(_WIN32)
+
+	void WorkerPoolData::Lock(void)
+	{
+		AcquireSRWLockExclusive(&poolMutex);
+	}
+
+	void WorkerPoolData::Unlock(void)
+	{
+		ReleaseSRWLockExclusive(&poolMutex);
+	}
+
+	void WorkerPoolData::WaitStart(void)
+	{
+		SleepConditionVariableSRW(&startCondition, &poolMutex, INFINITE, 0);
+	}
+
+	void WorkerPoolData::WaitFinish(void)
+	{
+		SleepConditionVariableSRW(&finishCondition, &poolMutex, INFINITE, 0);
+	}
+
+	static DWORD WINAPI WorkerThreadProc(LPVOID cookie)
+	{
+		static_cast<WorkerPoolData *>(cookie)->WorkerLoop();
+		return (0);
+	}
+
+#else
+
+	void WorkerPoolData::Lock(void)
+	{
+		pthread_mutex_lock(&poolMutex);
+	}
+
+	void WorkerPoolData::Unlock(void)
+	{
+		pthread_mutex_unlock(&poolMutex);
+	}
+
+	void WorkerPoolData::WaitStart(void)
+	{
+		pthread_cond_wait(&startCondition, &poolMutex);
+	}
+
+	void WorkerPoolData::WaitFinish(void)
+	{
+		pthread_cond_wait(&finishCondition, &poolMutex);
+	}
+
+	static void *WorkerThreadProc(void *cookie)
+	{
+		static_cast<WorkerPoolData *>(cookie)->WorkerLoop();
+		return (nullptr);
+	}
+
+#endif
+
+
+void WorkerPoolData::RunJobs(void)
+{
+	// Jobs are handed out one at a time through an atomic counter so that threads
+	// finishing early keep taking work until the whole batch has been claimed.
+
+	for (;;)
+	{
+		int32 index = AtomicAdd(&nextJobIndex, 1);
+		if (index >= jobCount)
+		{
+			break;
+		}
+
+		jobProc(index, jobCookie);
+	}
+}
+
+void WorkerPoolData::WorkerLoop(void)
+{
+	int32 generation = 0;
+
+	Lock();
+	for (;;)
+	{
+		while ((batchGeneration == generation) && (!terminateFlag))
+		{
+			WaitStart();
+		}
+
+		if (terminateFlag)
+		{
+			break;
+		}
+
+		generation = batchGeneration;
+		Unlock();
+
+		RunJobs();
+
+		Lock();
+		if (--busyWorkerCount == 0)
+		{
+			#if defined(_WIN32)
+
+				WakeConditionVariable(&finishCondition);
+
+			#else
+
+				pthread_cond_signal(&finishCondition);
+
+			#endif
+		}
+	}
+
+	Unlock();
+}
+
+
+WorkerPool::WorkerPool(int32 count)
+{
+	if (count < 0)
+	{
+		count = GetProcessorCount();
+	}
+
+	threadCount = Max(count, 1);
+	poolData = nullptr;
+
+	int32 workerCount = threadCount - 1;
+	if (workerCount > 0)
+	{
+		WorkerPoolData *data = new WorkerPoolData;
+		poolData = data;
+
+		data->workerCount = workerCount;
+		data->batchGeneration = 0;
+		data->busyWorkerCount = 0;
+		data->terminateFlag = false;
+		data->jobProc = nullptr;
+		data->jobCookie = nullptr;
+		data->jobCount = 0;
+		data->nextJobIndex = 0;
+
+		#if defined(_WIN32)
+
+			InitializeSRWLock(&data->poolMutex);
+			InitializeConditionVariable(&data->startCondition);
+			InitializeConditionVariable(&data->finishCondition);
+
+			data->threadHandle = new HANDLE[workerCount];
+			for (machine a = 0; a < workerCount; a++)
+			{
+				data->threadHandle[a] = CreateThread(nullptr, 0, &WorkerThreadProc, data, 0, nullptr);
+			}
+
+		#else
+
+			pthread_mutex_init(&data->poolMutex, nullptr);
+			pthread_cond_init(&data->startCondition, nullptr);
+			pthread_cond_init(&data->finishCondition, nullptr);
+
+			data->threadHandle = new pthread_t[workerCount];
+			for (machine a = 0; a < workerCount; a++)
+			{
+				pthread_create(&data->threadHandle[a], nullptr, &WorkerThreadProc, data);
+			}
+
+		#endif
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	WorkerPoolData *data = poolData;
+	if (data)
+	{
+		data->Lock();
+		data->terminateFlag = true;
+
+		#if defined(_WIN32)
+
+			WakeAllConditionVariable(&data->startCondition);
+			data->Unlock();
+
+			for (machine a = 0; a < data->workerCount; a++)
+			{
+				WaitForSingleObject(data->threadHandle[a], INFINITE);
+				CloseHandle(data->threadHandle[a]);
+			}
+
+		#else
+
+			pthread_cond_broadcast(&data->startCondition);
+			data->Unlock();
+
+			for (machine a = 0; a < data->workerCount; a++)
+			{
+				pthread_join(data->threadHandle[a], nullptr);
+			}
+
+			pthread_cond_destroy(&data->finishCondition);
+			pthread_cond_destroy(&data->startCondition);
+			pthread_mutex_destroy(&data->poolMutex);
+
+		#endif
+
+		delete[] data->threadHandle;
+		delete data;
+	}
+}
+
+int32 WorkerPool::GetProcessorCount(void)
+{
+	#if defined(_WIN32)
+
+		SYSTEM_INFO		systemInfo;
+
+		GetSystemInfo(&systemInfo);
+		return (Max(int32(systemInfo.dwNumberOfProcessors), 1));
+
+	#else
+
+		return (Max(int32(sysconf(_SC_NPROCESSORS_ONLN)), 1));
+
+	#endif
+}
+
+void WorkerPool::ExecuteJobs(int32 jobCount, WorkerJobProc *proc, void *cookie)
+{
+	WorkerPoolData *data = poolData;
+	if ((!data) || (jobCount <= 1))
+	{
+		for (machine a = 0; a < jobCount; a++)
+		{
+			proc(int32(a), cookie);
+		}
+
+		return;
+	}
+
+	data->Lock();
+	data->jobProc = proc;
+	data->jobCookie = cookie;
+	data->jobCount = jobCount;
+	data->nextJobIndex = 0;
+	data->busyWorkerCount = data->workerCount;
+	data->batchGeneration++;
+
+	#if defined(_WIN32)
+
+		WakeAllConditionVariable(&data->startCondition);
+
+	#else
+
+		pthread_cond_broadcast(&data->startCondition);
+
+	#endif
+
+	data->Unlock();
+
+	data->RunJobs();
+
+	// Every worker checks in before this returns, so none of them can still be
+	// reading the job fields when the next batch overwrites them.
+
+	data->Lock();
+	while (data->busyWorkerCount != 0)
+	{
+		data->WaitFinish();
+	}
+
+	data->Unlock();
+}
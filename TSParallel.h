@@ -0,0 +1,499 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSParallel_h
+#define TSParallel_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSSort.h"
+
+
+#define TERATHON_PARALLEL 1
+
+
+namespace Terathon
+{
+	struct WorkerPoolData;
+
+
+	typedef void WorkerJobProc(int32 index, void *cookie);
+
+
+	//# \class	WorkerPool		Manages a set of worker threads that execute jobs in parallel.
+	//
+	//# The $WorkerPool$ class manages a fixed set of worker threads for fork-join parallelism.
+	//
+	//# \def	class WorkerPool
+	//
+	//# \ctor	explicit WorkerPool(int32 threadCount = -1);
+	//
+	//# \param	threadCount		The total number of threads that execute jobs, including the calling thread. If this is &minus;1,
+	//#							then the number of logical processors in the system is used.
+	//
+	//# \desc
+	//# The $WorkerPool$ class launches $threadCount&#x202F;&minus;&#x202F;1$ worker threads when it is constructed. These threads
+	//# sleep until the $@WorkerPool::ExecuteJobs@$ function is called, and the thread calling that function participates in
+	//# executing the jobs, so $threadCount$ threads work on each batch. If $threadCount$ is 1, then no worker threads are
+	//# launched, and all jobs are executed serially on the calling thread. The worker threads are terminated when the
+	//# $WorkerPool$ object is destroyed.
+	//#
+	//# The $@ParallelSort@$, $@ParallelForEach@$, and $@ParallelTransform@$ functions distribute work over the threads
+	//# belonging to a worker pool.
+	//
+	//# \also	$@ParallelSort@$
+	//# \also	$@ParallelForEach@$
+	//# \also	$@ParallelTransform@$
+
+
+	//# \function	WorkerPool::GetThreadCount		Returns the number of threads that execute jobs.
+	//
+	//# \proto	int32 GetThreadCount(void) const;
+	//
+	//# \desc
+	//# The $GetThreadCount$ function returns the total number of threads that execute jobs for a worker pool, including the
+	//# thread that calls the $@WorkerPool::ExecuteJobs@$ function.
+
+
+	//# \function	WorkerPool::ExecuteJobs		Executes a batch of jobs in parallel and waits for them to finish.
+	//
+	//# \proto	void ExecuteJobs(int32 jobCount, WorkerJobProc *proc, void *cookie);
+	//
+	//# \param	jobCount	The number of jobs to execute.
+	//# \param	proc		The function that executes each job.
+	//# \param	cookie		The cookie that is passed to the job function.
+	//
+	//# \desc
+	//# The $ExecuteJobs$ function calls the function specified by the $proc$ parameter $jobCount$ times, once for each job
+	//# index in the range [0,&#x202F;$jobCount$&#x202F;&minus;&#x202F;1], and returns after all of the calls have returned.
+	//# The calls are distributed dynamically over the worker threads and the calling thread, so jobs should be small enough
+	//# that there are several per thread. The $WorkerJobProc$ type is defined as follows.
+	//
+	//# \source
+	//# typedef void WorkerJobProc(int32 index, void *cookie);
+	//
+	//# \desc
+	//# The $ExecuteJobs$ function must not be called from inside a job, and it must not be called for the same worker pool
+	//# by more than one thread at a time.
+
+
+	class WorkerPool
+	{
+		private:
+
+			int32				threadCount;
+			WorkerPoolData		*poolData;
+
+			WorkerPool(const WorkerPool&) = delete;
+			WorkerPool& operator =(const WorkerPool&) = delete;
+
+		public:
+
+			TERATHON_API explicit WorkerPool(int32 count = -1);
+			TERATHON_API ~WorkerPool();
+
+			int32 GetThreadCount(void) const
+			{
+				return (threadCount);
+			}
+
+			TERATHON_API void ExecuteJobs(int32 jobCount, WorkerJobProc *proc, void *cookie);
+
+			TERATHON_API static int32 GetProcessorCount(void);
+	};
+
+
+	//# \function	ParallelForEach		Calls a function for every element of an array in parallel.
+	//
+	//# \proto	template <typename type, typename countType, class functionType> void ParallelForEach(WorkerPool *pool, ImmutableArray<type, countType>& array, const functionType& function);
+	//
+	//# \param	pool		The worker pool whose threads execute the function.
+	//# \param	array		The array whose elements are processed.
+	//# \param	function	A callable object that takes a reference to an array element.
+	//
+	//# \desc
+	//# The $ParallelForEach$ function calls the function specified by the $function$ parameter once for each element of an array.
+	//# The array is divided into contiguous chunks that are processed by the threads belonging to the worker pool, so the
+	//# function may be called for different elements simultaneously, and the order of the calls is unspecified.
+	//#
+	//# Chunks always contain at least 16&#x202F;KB worth of elements so that small elements are processed in large enough runs
+	//# to amortize scheduling overhead, and there are several chunks per thread so that the load stays balanced. If the whole
+	//# array fits in a single chunk, then the function is called serially on the calling thread.
+	//
+	//# \also	$@ParallelTransform@$
+	//# \also	$@ParallelSort@$
+	//# \also	$@WorkerPool@$
+
+
+	//# \function	ParallelTransform		Transforms every element of an array in parallel.
+	//
+	//# \proto	template <typename type, typename resultType, typename countType, class functionType> void ParallelTransform(WorkerPool *pool, const ImmutableArray<type, countType>& source, ImmutableArray<resultType, countType>& result, const functionType& function);
+	//
+	//# \param	pool		The worker pool whose threads execute the function.
+	//# \param	source		The array whose elements are transformed.
+	//# \param	result		The array that receives the transformed elements.
+	//# \param	function	A callable object that takes a reference to an element of the source array and returns a value.
+	//
+	//# \desc
+	//# The $ParallelTransform$ function assigns the value returned by the function specified by the $function$ parameter for
+	//# each element of the $source$ array to the element having the same index in the $result$ array. The $result$ array must
+	//# already contain at least as many elements as the $source$ array, and it can be the same array as the $source$ array.
+	//# The work is divided into chunks in the same way as it is for the $@ParallelForEach@$ function.
+	//
+	//# \also	$@ParallelForEach@$
+	//# \also	$@ParallelSort@$
+	//# \also	$@WorkerPool@$
+
+
+	//# \function	ParallelSort		Sorts an array in parallel.
+	//
+	//# \proto	template <typename type, typename countType, class comparatorType, class allocatorType, class growthType> void ParallelSort(WorkerPool *pool, ImmutableArray<type, countType>& array, const comparatorType& compare, Array<type, 0, allocatorType, countType, growthType>& scratch);
+	//# \proto	template <typename type, typename countType, class comparatorType> void ParallelSort(WorkerPool *pool, ImmutableArray<type, countType>& array, const comparatorType& compare);
+	//# \proto	template <typename type, typename countType> void ParallelSort(WorkerPool *pool, ImmutableArray<type, countType>& array);
+	//
+	//# \param	pool		The worker pool whose threads perform the sort.
+	//# \param	array		The array to sort.
+	//# \param	compare		The comparator that determines the order of the elements. If omitted, the $<$ operator is used.
+	//# \param	scratch		An empty array whose storage is used as temporary space during the sort.
+	//
+	//# \desc
+	//# The $ParallelSort$ function sorts the elements of an array in place using the threads belonging to a worker pool. The array
+	//# is divided into chunks that are sorted independently with the $@SortArray@$ function, and the sorted runs are then combined
+	//# by successive merge passes. Each merge pass is itself divided into equal-size pieces of output that are merged in parallel,
+	//# so all threads remain busy until the end of the sort. The sort is not stable.
+	//#
+	//# The merge passes need temporary space for the same number of elements as the array. This space is taken from the reserved
+	//# storage of the $scratch$ array, which must be empty. The element count of the $scratch$ array is not changed, but its
+	//# storage is enlarged if necessary. If the $scratch$ parameter is omitted, then a temporary array is allocated for the
+	//# duration of the sort. If the array is small enough to fit in a single chunk, then it is sorted serially without using
+	//# the scratch array.
+	//
+	//# \also	$@SortArray@$
+	//# \also	$@ParallelForEach@$
+	//# \also	$@WorkerPool@$
+
+
+	namespace Parallel
+	{
+		enum
+		{
+			kMinChunkSize			= 16384,
+			kChunksPerThread		= 4
+		};
+
+
+		inline machine GetChunkElementCount(machine count, umachine elementSize, int32 threadCount)
+		{
+			// Chunks hold at least kMinChunkSize bytes so that tiny elements are not scheduled one
+			// cache line at a time, and there are kChunksPerThread chunks per thread when possible.
+
+			machine minCount = Max64(machine(kMinChunkSize / elementSize), 1);
+			machine chunkCount = machine(threadCount) * kChunksPerThread;
+			return (Max64((count + chunkCount - 1) / chunkCount, minCount));
+		}
+
+
+		template <typename type, class functionType>
+		struct ForEachJob
+		{
+			type					*array;
+			machine					count;
+			machine					chunkSize;
+			const functionType		*function;
+
+			static void Execute(int32 index, void *cookie)
+			{
+				const ForEachJob *job = static_cast<ForEachJob *>(cookie);
+
+				machine begin = index * job->chunkSize;
+				machine end = Min64(begin + job->chunkSize, job->count);
+
+				type *array = job->array;
+				const functionType& function = *job->function;
+				for (machine a = begin; a < end; a++)
+				{
+					function(array[a]);
+				}
+			}
+		};
+
+
+		template <typename type, typename resultType, class functionType>
+		struct TransformJob
+		{
+			const type				*source;
+			resultType				*result;
+			machine					count;
+			machine					chunkSize;
+			const functionType		*function;
+
+			static void Execute(int32 index, void *cookie)
+			{
+				const TransformJob *job = static_cast<TransformJob *>(cookie);
+
+				machine begin = index * job->chunkSize;
+				machine end = Min64(begin + job->chunkSize, job->count);
+
+				const type *source = job->source;
+				resultType *result = job->result;
+				const functionType& function = *job->function;
+				for (machine a = begin; a < end; a++)
+				{
+					result[a] = function(source[a]);
+				}
+			}
+		};
+
+
+		template <typename type, class comparatorType>
+		struct SortJob
+		{
+			type					*array;
+			machine					count;
+			machine					chunkSize;
+			const comparatorType	*compare;
+
+			static void Execute(int32 index, void *cookie)
+			{
+				const SortJob *job = static_cast<SortJob *>(cookie);
+
+				machine begin = index * job->chunkSize;
+				machine end = Min64(begin + job->chunkSize, job->count);
+				SortArray(job->array + begin, end - begin, *job->compare);
+			}
+		};
+
+
+		template <typename type, class comparatorType>
+		machine FindMergeSplit(const type *first, machine firstCount, const type *second, machine secondCount, machine k, const comparatorType& compare)
+		{
+			// Returns the number of elements taken from the first run when the first k elements
+			// of the stable merge of both runs have been output. Ties go to the first run.
+
+			machine low = Max64(k - secondCount, 0);
+			machine high = Min64(k, firstCount);
+
+			while (low < high)
+			{
+				machine i = (low + high) >> 1;
+				machine j = k - i;
+				if ((j > 0) && (!compare(second[j - 1], first[i])))
+				{
+					low = i + 1;
+				}
+				else
+				{
+					high = i;
+				}
+			}
+
+			return (low);
+		}
+
+
+		template <typename type, class comparatorType>
+		struct MergeJob
+		{
+			type					*source;
+			type					*dest;
+			machine					count;
+			machine					runSize;
+			machine					chunkSize;
+			machine					chunksPerPair;
+			const machine			*splitTable;
+			const comparatorType	*compare;
+
+			static machine FindChunkSplit(const MergeJob *job, int32 index)
+			{
+				// Split points are calculated for every chunk before any merge job runs because the
+				// merge jobs relocate elements that the searches for other chunks would examine.
+
+				machine pairBegin = (index / job->chunksPerPair) * job->runSize * 2;
+				machine pairCount = Min64(job->runSize * 2, job->count - pairBegin);
+
+				machine outputBegin = (index % job->chunksPerPair) * job->chunkSize;
+				if (outputBegin >= pairCount)
+				{
+					return (0);
+				}
+
+				const type *first = job->source + pairBegin;
+				machine firstCount = Min64(job->runSize, pairCount);
+				return (FindMergeSplit(first, firstCount, first + firstCount, pairCount - firstCount, outputBegin, *job->compare));
+			}
+
+			static void Execute(int32 index, void *cookie)
+			{
+				const MergeJob *job = static_cast<const MergeJob *>(cookie);
+				const comparatorType& compare = *job->compare;
+
+				machine pairBegin = (index / job->chunksPerPair) * job->runSize * 2;
+				machine pairCount = Min64(job->runSize * 2, job->count - pairBegin);
+
+				machine outputBegin = (index % job->chunksPerPair) * job->chunkSize;
+				if (outputBegin >= pairCount)
+				{
+					return;
+				}
+
+				machine outputEnd = Min64(outputBegin + job->chunkSize, pairCount);
+
+				type *first = job->source + pairBegin;
+				machine firstCount = Min64(job->runSize, pairCount);
+				type *second = first + firstCount;
+
+				machine i = job->splitTable[index];
+				machine j = outputBegin - i;
+				machine iEnd = (outputEnd < pairCount) ? job->splitTable[index + 1] : firstCount;
+				machine jEnd = outputEnd - iEnd;
+
+				type *dest = job->dest + (pairBegin + outputBegin);
+				while ((i < iEnd) && (j < jEnd))
+				{
+					if (compare(second[j], first[i]))
+					{
+						RelocateArrayElements(dest++, &second[j++], 1);
+					}
+					else
+					{
+						RelocateArrayElements(dest++, &first[i++], 1);
+					}
+				}
+
+				RelocateArrayElements(dest, &first[i], iEnd - i);
+				RelocateArrayElements(dest + (iEnd - i), &second[j], jEnd - j);
+			}
+		};
+	}
+
+
+	template <typename type, typename countType, class functionType>
+	void ParallelForEach(WorkerPool *pool, ImmutableArray<type, countType>& array, const functionType& function)
+	{
+		Parallel::ForEachJob<type, functionType>	job;
+
+		job.array = array;
+		job.count = array.GetArrayElementCount();
+		job.chunkSize = Parallel::GetChunkElementCount(job.count, sizeof(type), pool->GetThreadCount());
+		job.function = &function;
+
+		int32 jobCount = int32((job.count + job.chunkSize - 1) / job.chunkSize);
+		if (jobCount > 1)
+		{
+			pool->ExecuteJobs(jobCount, &Parallel::ForEachJob<type, functionType>::Execute, &job);
+		}
+		else if (jobCount == 1)
+		{
+			Parallel::ForEachJob<type, functionType>::Execute(0, &job);
+		}
+	}
+
+	template <typename type, typename resultType, typename countType, class functionType>
+	void ParallelTransform(WorkerPool *pool, const ImmutableArray<type, countType>& source, ImmutableArray<resultType, countType>& result, const functionType& function)
+	{
+		Parallel::TransformJob<type, resultType, functionType>		job;
+
+		job.source = source;
+		job.result = result;
+		job.count = source.GetArrayElementCount();
+		job.chunkSize = Parallel::GetChunkElementCount(job.count, sizeof(type), pool->GetThreadCount());
+		job.function = &function;
+
+		int32 jobCount = int32((job.count + job.chunkSize - 1) / job.chunkSize);
+		if (jobCount > 1)
+		{
+			pool->ExecuteJobs(jobCount, &Parallel::TransformJob<type, resultType, functionType>::Execute, &job);
+		}
+		else if (jobCount == 1)
+		{
+			Parallel::TransformJob<type, resultType, functionType>::Execute(0, &job);
+		}
+	}
+
+	template <typename type, typename countType, class comparatorType, class allocatorType, class growthType>
+	void ParallelSort(WorkerPool *pool, ImmutableArray<type, countType>& array, const comparatorType& compare, Array<type, 0, allocatorType, countType, growthType>& scratch)
+	{
+		type *pointer = array;
+		machine count = array.GetArrayElementCount();
+
+		machine chunkSize = Parallel::GetChunkElementCount(count, sizeof(type), pool->GetThreadCount());
+		if (count <= chunkSize)
+		{
+			SortArray(pointer, count, compare);
+			return;
+		}
+
+		Parallel::SortJob<type, comparatorType>		sortJob;
+
+		sortJob.array = pointer;
+		sortJob.count = count;
+		sortJob.chunkSize = chunkSize;
+		sortJob.compare = &compare;
+		pool->ExecuteJobs(int32((count + chunkSize - 1) / chunkSize), &Parallel::SortJob<type, comparatorType>::Execute, &sortJob);
+
+		scratch.ReserveArrayElementCount(countType(count));
+
+		Array<machine>								splitTable;
+		Parallel::MergeJob<type, comparatorType>	mergeJob;
+
+		mergeJob.source = pointer;
+		mergeJob.dest = scratch;
+		mergeJob.count = count;
+		mergeJob.chunkSize = chunkSize;
+		mergeJob.compare = &compare;
+
+		for (machine runSize = chunkSize; runSize < count; runSize *= 2)
+		{
+			machine pairCount = (count + runSize * 2 - 1) / (runSize * 2);
+			mergeJob.runSize = runSize;
+			mergeJob.chunksPerPair = (runSize * 2 + chunkSize - 1) / chunkSize;
+
+			int32 jobCount = int32(pairCount * mergeJob.chunksPerPair);
+			splitTable.SetArrayElementCount(jobCount);
+			for (machine a = 0; a < jobCount; a++)
+			{
+				splitTable[a] = Parallel::MergeJob<type, comparatorType>::FindChunkSplit(&mergeJob, int32(a));
+			}
+
+			mergeJob.splitTable = splitTable;
+			pool->ExecuteJobs(jobCount, &Parallel::MergeJob<type, comparatorType>::Execute, &mergeJob);
+
+			type *temp = mergeJob.source;
+			mergeJob.source = mergeJob.dest;
+			mergeJob.dest = temp;
+		}
+
+		if (mergeJob.source != pointer)
+		{
+			RelocateArrayElements(pointer, mergeJob.source, count);
+		}
+	}
+
+	template <typename type, typename countType, class comparatorType>
+	inline void ParallelSort(WorkerPool *pool, ImmutableArray<type, countType>& array, const comparatorType& compare)
+	{
+		Array<type, 0, HeapArrayAllocator, countType>		scratch;
+
+		ParallelSort(pool, array, compare, scratch);
+	}
+
+	template <typename type, typename countType>
+	inline void ParallelSort(WorkerPool *pool, ImmutableArray<type, countType>& array)
+	{
+		Array<type, 0, HeapArrayAllocator, countType>		scratch;
+
+		ParallelSort(pool, array, SortComparator<type>(), scratch);
+	}
+}
+
+
+#endif
@@ -78,6 +78,11 @@
 
 		void *__cdecl memset(void *, int, size_t);
 		#pragma intrinsic(memset)
+
+		void *__cdecl memmove(void *, const void *, size_t);
+
+		int __cdecl memcmp(const void *, const void *, size_t);
+		#pragma intrinsic(memcmp)
 	}
 
 #else
@@ -91,6 +96,7 @@
 	#endif
 
 	#include <new>
+	#include <stdlib.h>
 	#include <string.h>
 
 	#if defined(_MSC_VER)
@@ -102,6 +108,35 @@
 #endif
 
 
+#if !defined(TERATHON_NO_SIMD)
+
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+
+		#define TERATHON_SSE2 1
+
+		#if defined(__AVX2__)
+
+			#define TERATHON_AVX2 1
+
+			#include <immintrin.h>
+
+		#else
+
+			#include <emmintrin.h>
+
+		#endif
+
+	#elif defined(__ARM_NEON) || defined(_M_ARM64)
+
+		#define TERATHON_NEON 1
+
+		#include <arm_neon.h>
+
+	#endif
+
+#endif
+
+
 namespace Terathon
 {
 	#if defined(_MSC_VER)
@@ -213,21 +248,27 @@ namespace Terathon
 
 
 	#undef CopyMemory
+	#undef MoveMemory
 	#undef FillMemory
 	#undef ClearMemory
 
 
-	inline void CopyMemory(const void *source, void *dest, uint32 size)
+	inline void CopyMemory(const void *source, void *dest, umachine size)
 	{
 		memcpy(dest, source, size);
 	}
 
-	inline void FillMemory(void *ptr, uint32 size, uint8 value)
+	inline void MoveMemory(const void *source, void *dest, umachine size)
+	{
+		memmove(dest, source, size);
+	}
+
+	inline void FillMemory(void *ptr, umachine size, uint8 value)
 	{
 		memset(ptr, value, size);
 	}
 
-	inline void ClearMemory(void *ptr, uint32 size)
+	inline void ClearMemory(void *ptr, umachine size)
 	{
 		memset(ptr, 0, size);
 	}
@@ -0,0 +1,714 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSRingArray_h
+#define TSRingArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_RINGARRAY 1
+
+
+namespace Terathon
+{
+	template <typename type>
+	class RingArrayIterator
+	{
+		private:
+
+			type		*ringPointer;
+			machine		ringMask;
+			machine		elementIndex;
+
+		public:
+
+			RingArrayIterator(type *pointer, machine mask, machine index) : ringPointer(pointer), ringMask(mask), elementIndex(index) {}
+
+			type& operator *(void) const
+			{
+				return (ringPointer[elementIndex & ringMask]);
+			}
+
+			RingArrayIterator& operator ++(void)
+			{
+				elementIndex++;
+				return (*this);
+			}
+
+			bool operator ==(const RingArrayIterator& iterator) const
+			{
+				return (elementIndex == iterator.elementIndex);
+			}
+
+			bool operator !=(const RingArrayIterator& iterator) const
+			{
+				return (elementIndex != iterator.elementIndex);
+			}
+	};
+
+
+	//# \class	RingArray		A container class that holds a double-ended queue of objects.
+	//
+	//# The $RingArray$ class represents a dynamically resizable array of objects to which elements can be added
+	//# and from which elements can be removed at both ends in constant time.
+	//
+	//# \def	template <typename type, int32 baseCount = 0, class allocatorType = HeapArrayAllocator> class RingArray final
+	//
+	//# \tparam		type			The type of the class that can be stored in the array.
+	//# \tparam		baseCount		The number of elements for which storage space is built into the $RingArray$ object. This must be zero or a power of two.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the array when it grows beyond $baseCount$ elements.
+	//
+	//# \ctor	RingArray();
+	//# \ctor	explicit RingArray(const allocatorType& allocator);
+	//
+	//# \param	allocator	An allocator object that is copied into the array and used for all of its storage.
+	//
+	//# \desc
+	//# The $RingArray$ class template stores its elements in a circular buffer whose capacity is always a power of two,
+	//# so the storage location of any element is found by masking its position instead of performing a division. The
+	//# first element of the array can be located anywhere in the buffer, and the elements wrap around to the beginning
+	//# of the buffer when they reach its end. This makes it possible to add or remove elements at either end of the array
+	//# without moving any other elements, so a ring array is well suited for use as a first-in first-out queue. In
+	//# contrast, removing the first element of an $@Array@$ object requires all of the remaining elements to be moved.
+	//#
+	//# Like the $@Array@$ class template, the $baseCount$ template parameter specifies the number of elements for which
+	//# storage is built into the $RingArray$ object itself, and no memory is allocated until the array holds more elements
+	//# than that. When the array needs to grow, its capacity is doubled, and the elements are moved into the new buffer
+	//# so that the first element is stored at the beginning of the buffer.
+	//#
+	//# Because the elements can wrap around the end of the buffer, they occupy at most two contiguous spans of memory.
+	//# These spans are returned by the $@RingArray::GetFirstArraySpan@$ and $@RingArray::GetSecondArraySpan@$ functions,
+	//# allowing the contents of the array to be processed or copied in bulk. After the elements in the spans have been
+	//# consumed, they can be removed with a single call to the $@RingArray::RemoveFirstArrayElements@$ function.
+	//#
+	//# Elements are accessed in constant time with the $[]$ operator, where index 0 always refers to the first element.
+	//# It is also possible to iterate over the elements of a ring array from first to last using a range-based for loop.
+	//# This is illustrated by the following code, where $array$ is a variable of type $RingArray<type>$.
+	//
+	//# \source
+	//# for (type& element : array)\n
+	//# {\n
+	//# \t...\n
+	//# }
+	//
+	//# \also	$@Array@$
+
+
+	//# \function	RingArray::GetArrayElementCount		Returns the current size of an array.
+	//
+	//# \proto	int32 GetArrayElementCount(void) const;
+	//
+	//# \desc
+	//# The $GetArrayElementCount$ function returns the number of elements currently stored in a ring array.
+	//
+	//# \also	$@RingArray::GetArrayReservedCount@$
+
+
+	//# \function	RingArray::GetArrayReservedCount		Returns the number of elements for which space has been allocated.
+	//
+	//# \proto	int32 GetArrayReservedCount(void) const;
+	//
+	//# \desc
+	//# The $GetArrayReservedCount$ function returns the capacity of the buffer in which a ring array stores its elements.
+	//# The capacity is always zero or a power of two.
+	//
+	//# \also	$@RingArray::ReserveArrayElementCount@$
+
+
+	//# \function	RingArray::GetFirstArrayElement		Returns a pointer to the first element in an array.
+	//
+	//# \proto	type *GetFirstArrayElement(void) const;
+	//
+	//# \desc
+	//# The $GetFirstArrayElement$ function returns a pointer to the first element in a ring array. If the array is empty,
+	//# then the return value is $nullptr$.
+	//
+	//# \also	$@RingArray::GetLastArrayElement@$
+
+
+	//# \function	RingArray::GetLastArrayElement		Returns a pointer to the last element in an array.
+	//
+	//# \proto	type *GetLastArrayElement(void) const;
+	//
+	//# \desc
+	//# The $GetLastArrayElement$ function returns a pointer to the last element in a ring array. If the array is empty,
+	//# then the return value is $nullptr$.
+	//
+	//# \also	$@RingArray::GetFirstArrayElement@$
+
+
+	//# \function	RingArray::GetFirstArraySpan		Returns the first contiguous span of elements in an array.
+	//
+	//# \proto	type *GetFirstArraySpan(int32 *count) const;
+	//
+	//# \param	count	A pointer to a location that receives the number of elements in the span.
+	//
+	//# \desc
+	//# The $GetFirstArraySpan$ function returns a pointer to the first element in a ring array and stores the number of
+	//# elements that follow it contiguously in memory, including the first element itself, in the location specified by
+	//# the $count$ parameter. If the elements do not wrap around the end of the buffer, then this span contains all of
+	//# the elements in the array. Otherwise, the remaining elements are returned by the $@RingArray::GetSecondArraySpan@$
+	//# function.
+	//
+	//# \also	$@RingArray::GetSecondArraySpan@$
+	//# \also	$@RingArray::RemoveFirstArrayElements@$
+
+
+	//# \function	RingArray::GetSecondArraySpan		Returns the second contiguous span of elements in an array.
+	//
+	//# \proto	type *GetSecondArraySpan(int32 *count) const;
+	//
+	//# \param	count	A pointer to a location that receives the number of elements in the span.
+	//
+	//# \desc
+	//# The $GetSecondArraySpan$ function returns a pointer to the elements of a ring array that wrapped around to the
+	//# beginning of the buffer and stores the number of those elements in the location specified by the $count$ parameter.
+	//# These elements immediately follow the elements returned by the $@RingArray::GetFirstArraySpan@$ function. If the
+	//# elements do not wrap around, then the number of elements in the second span is zero.
+	//
+	//# \also	$@RingArray::GetFirstArraySpan@$
+
+
+	//# \function	RingArray::ClearArray		Removes all elements from an array.
+	//
+	//# \proto	void ClearArray(void);
+	//
+	//# \desc
+	//# The $ClearArray$ function destroys all of the elements in a ring array and sets its size to zero.
+	//# The storage allocated by the array is retained.
+	//
+	//# \also	$@RingArray::PurgeArray@$
+
+
+	//# \function	RingArray::PurgeArray		Removes all elements from an array and deallocates its storage.
+	//
+	//# \proto	void PurgeArray(void);
+	//
+	//# \desc
+	//# The $PurgeArray$ function destroys all of the elements in a ring array, sets its size to zero, and releases
+	//# any storage that was allocated for the array.
+	//
+	//# \also	$@RingArray::ClearArray@$
+
+
+	//# \function	RingArray::ReserveArrayElementCount		Allocates storage for a specific number of elements.
+	//
+	//# \proto	void ReserveArrayElementCount(int32 count);
+	//
+	//# \param	count	The minimum number of elements for which space is reserved.
+	//
+	//# \desc
+	//# The $ReserveArrayElementCount$ function increases the capacity of a ring array to the smallest power of two that is
+	//# at least as large as the $count$ parameter. If the capacity is already large enough, then this function has no effect.
+	//
+	//# \also	$@RingArray::GetArrayReservedCount@$
+
+
+	//# \function	RingArray::AppendArrayElement		Adds an object to the end of an array.
+	//
+	//# \proto	template <typename T> type *AppendArrayElement(T&& element);
+	//
+	//# \param	element		The new element to add to the array.
+	//
+	//# \desc
+	//# The $AppendArrayElement$ function increases the size of a ring array by one and initializes the new last element
+	//# with the value of the $element$ parameter. The return value is a pointer to the new element.
+	//
+	//# \also	$@RingArray::PrependArrayElement@$
+	//# \also	$@RingArray::EmplaceArrayElement@$
+	//# \also	$@RingArray::AppendArrayElements@$
+	//# \also	$@RingArray::RemoveLastArrayElement@$
+
+
+	//# \function	RingArray::PrependArrayElement		Adds an object to the beginning of an array.
+	//
+	//# \proto	template <typename T> type *PrependArrayElement(T&& element);
+	//
+	//# \param	element		The new element to add to the array.
+	//
+	//# \desc
+	//# The $PrependArrayElement$ function increases the size of a ring array by one and initializes the new first element
+	//# with the value of the $element$ parameter. The indexes of all existing elements increase by one, but none of them
+	//# are moved in memory. The return value is a pointer to the new element.
+	//
+	//# \also	$@RingArray::AppendArrayElement@$
+	//# \also	$@RingArray::RemoveFirstArrayElement@$
+
+
+	//# \function	RingArray::EmplaceArrayElement		Constructs a new object at the end of an array.
+	//
+	//# \proto	template <typename... T> type *EmplaceArrayElement(T&&... args);
+	//
+	//# \param	args	The arguments that are forwarded to the constructor of the new element.
+	//
+	//# \desc
+	//# The $EmplaceArrayElement$ function increases the size of a ring array by one and constructs the new last element
+	//# in place by passing the arguments specified by the $args$ parameter to its constructor. The return value is a
+	//# pointer to the new element.
+	//
+	//# \also	$@RingArray::AppendArrayElement@$
+
+
+	//# \function	RingArray::AppendArrayElements		Adds multiple objects to the end of an array.
+	//
+	//# \proto	void AppendArrayElements(const type *elements, int32 count);
+	//
+	//# \param	elements	A pointer to the elements to add to the array.
+	//# \param	count		The number of elements to add.
+	//
+	//# \desc
+	//# The $AppendArrayElements$ function copies $count$ elements to the end of a ring array. The elements are copied
+	//# into at most two contiguous spans of the buffer.
+	//
+	//# \also	$@RingArray::AppendArrayElement@$
+	//# \also	$@RingArray::RemoveFirstArrayElements@$
+
+
+	//# \function	RingArray::RemoveFirstArrayElement		Removes the first element in an array.
+	//
+	//# \proto	void RemoveFirstArrayElement(void);
+	//
+	//# \desc
+	//# The $RemoveFirstArrayElement$ function destroys the first element in a ring array and decreases its size by one.
+	//# The remaining elements are not moved. If the array is empty, then this function has no effect.
+	//
+	//# \also	$@RingArray::RemoveFirstArrayElements@$
+	//# \also	$@RingArray::RemoveLastArrayElement@$
+	//# \also	$@RingArray::PrependArrayElement@$
+
+
+	//# \function	RingArray::RemoveFirstArrayElements		Removes multiple elements from the beginning of an array.
+	//
+	//# \proto	void RemoveFirstArrayElements(int32 count);
+	//
+	//# \param	count	The number of elements to remove.
+	//
+	//# \desc
+	//# The $RemoveFirstArrayElements$ function destroys the first $count$ elements in a ring array and decreases its size
+	//# accordingly. If $count$ is greater than the size of the array, then all of the elements are removed. This function
+	//# is typically called after the elements returned by the $@RingArray::GetFirstArraySpan@$ and
+	//# $@RingArray::GetSecondArraySpan@$ functions have been consumed.
+	//
+	//# \also	$@RingArray::RemoveFirstArrayElement@$
+
+
+	//# \function	RingArray::RemoveLastArrayElement		Removes the last element in an array.
+	//
+	//# \proto	void RemoveLastArrayElement(void);
+	//
+	//# \desc
+	//# The $RemoveLastArrayElement$ function destroys the last element in a ring array and decreases its size by one.
+	//# If the array is empty, then this function has no effect.
+	//
+	//# \also	$@RingArray::RemoveFirstArrayElement@$
+	//# \also	$@RingArray::AppendArrayElement@$
+
+
+	template <typename type, int32 baseCount = 0, class allocatorType = HeapArrayAllocator>
+	class RingArray final : private allocatorType
+	{
+		static_assert((baseCount >= 0) && ((baseCount & (baseCount - 1)) == 0), "baseCount must be zero or a power of two");
+
+		private:
+
+			static const umachine kStorageAlignment = ArrayAlignment<type, 0>::value;
+			typedef AlignedArrayStorage<allocatorType, kStorageAlignment> storageType;
+
+			type		*ringPointer;
+			int32		ringCapacity;
+			int32		ringHead;
+			int32		elementCount;
+
+			alignas(kStorageAlignment) char		ringStorage[(baseCount != 0) ? baseCount * sizeof(type) : 1];
+
+			type *GetBaseStorage(void)
+			{
+				return ((baseCount != 0) ? reinterpret_cast<type *>(ringStorage) : nullptr);
+			}
+
+			type *GetElementPointer(machine index) const
+			{
+				return (&ringPointer[(ringHead + index) & (ringCapacity - 1)]);
+			}
+
+			int32 GetFirstSpanCount(void) const
+			{
+				return (Min(elementCount, ringCapacity - ringHead));
+			}
+
+			void SetReservedCount(int32 count);
+			void DestroyElements(int32 start, int32 finish);
+
+		public:
+
+			RingArray();
+			explicit RingArray(const allocatorType& allocator);
+			RingArray(const RingArray& array);
+			RingArray(RingArray&& array);
+			~RingArray();
+
+			RingArray& operator =(const RingArray&) = delete;
+
+			allocatorType& GetArrayAllocator(void)
+			{
+				return (*this);
+			}
+
+			const allocatorType& GetArrayAllocator(void) const
+			{
+				return (*this);
+			}
+
+			type& operator [](machine index)
+			{
+				return (*GetElementPointer(index));
+			}
+
+			const type& operator [](machine index) const
+			{
+				return (*GetElementPointer(index));
+			}
+
+			RingArrayIterator<type> begin(void) const
+			{
+				return (RingArrayIterator<type>(ringPointer, ringCapacity - 1, ringHead));
+			}
+
+			RingArrayIterator<type> end(void) const
+			{
+				return (RingArrayIterator<type>(ringPointer, ringCapacity - 1, machine(ringHead) + elementCount));
+			}
+
+			bool Empty(void) const
+			{
+				return (elementCount == 0);
+			}
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (elementCount);
+			}
+
+			int32 GetArrayReservedCount(void) const
+			{
+				return (ringCapacity);
+			}
+
+			type *GetFirstArrayElement(void) const
+			{
+				return ((elementCount != 0) ? &ringPointer[ringHead] : nullptr);
+			}
+
+			type *GetLastArrayElement(void) const
+			{
+				return ((elementCount != 0) ? GetElementPointer(elementCount - 1) : nullptr);
+			}
+
+			type *GetFirstArraySpan(int32 *count) const
+			{
+				*count = GetFirstSpanCount();
+				return (ringPointer + ringHead);
+			}
+
+			type *GetSecondArraySpan(int32 *count) const
+			{
+				*count = elementCount - GetFirstSpanCount();
+				return (ringPointer);
+			}
+
+			void ClearArray(void);
+			void PurgeArray(void);
+			void ReserveArrayElementCount(int32 count);
+
+			template <typename T>
+			type *AppendArrayElement(T&& element);
+
+			template <typename T>
+			type *PrependArrayElement(T&& element);
+
+			template <typename... T>
+			type *EmplaceArrayElement(T&&... args);
+
+			void AppendArrayElements(const type *elements, int32 count);
+
+			void RemoveFirstArrayElement(void);
+			void RemoveFirstArrayElements(int32 count);
+			void RemoveLastArrayElement(void);
+	};
+
+
+	template <typename type, int32 baseCount, class allocatorType>
+	RingArray<type, baseCount, allocatorType>::RingArray()
+	{
+		ringPointer = GetBaseStorage();
+		ringCapacity = baseCount;
+		ringHead = 0;
+		elementCount = 0;
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	RingArray<type, baseCount, allocatorType>::RingArray(const allocatorType& allocator) : allocatorType(allocator)
+	{
+		ringPointer = GetBaseStorage();
+		ringCapacity = baseCount;
+		ringHead = 0;
+		elementCount = 0;
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	RingArray<type, baseCount, allocatorType>::RingArray(const RingArray& array) : allocatorType(array)
+	{
+		int32 count = array.elementCount;
+		if (count > baseCount)
+		{
+			ringCapacity = array.ringCapacity;
+			ringPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, sizeof(type) * ringCapacity));
+		}
+		else
+		{
+			ringCapacity = baseCount;
+			ringPointer = GetBaseStorage();
+		}
+
+		ringHead = 0;
+		elementCount = count;
+
+		if (count != 0)
+		{
+			int32 firstCount = array.GetFirstSpanCount();
+			CopyArrayElements(ringPointer, array.ringPointer + array.ringHead, firstCount);
+			CopyArrayElements(ringPointer + firstCount, array.ringPointer, count - firstCount);
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	RingArray<type, baseCount, allocatorType>::RingArray(RingArray&& array) : allocatorType(static_cast<allocatorType&&>(array))
+	{
+		elementCount = array.elementCount;
+
+		if (array.ringCapacity > baseCount)
+		{
+			ringPointer = array.ringPointer;
+			ringCapacity = array.ringCapacity;
+			ringHead = array.ringHead;
+		}
+		else
+		{
+			ringPointer = GetBaseStorage();
+			ringCapacity = baseCount;
+			ringHead = 0;
+
+			if (elementCount != 0)
+			{
+				int32 firstCount = array.GetFirstSpanCount();
+				RelocateArrayElements(ringPointer, array.ringPointer + array.ringHead, firstCount);
+				RelocateArrayElements(ringPointer + firstCount, array.ringPointer, elementCount - firstCount);
+			}
+		}
+
+		array.ringPointer = array.GetBaseStorage();
+		array.ringCapacity = baseCount;
+		array.ringHead = 0;
+		array.elementCount = 0;
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	RingArray<type, baseCount, allocatorType>::~RingArray()
+	{
+		DestroyElements(0, elementCount);
+
+		if (ringCapacity > baseCount)
+		{
+			storageType::ReleaseArrayStorage(this, ringPointer, sizeof(type) * ringCapacity);
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::DestroyElements(int32 start, int32 finish)
+	{
+		for (machine a = finish - 1; a >= start; a--)
+		{
+			GetElementPointer(a)->~type();
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::SetReservedCount(int32 count)
+	{
+		// The ring is unrolled into the new buffer so that the first element is stored at the
+		// beginning, which leaves all of the free space in one contiguous block after the last element.
+
+		int32 newCapacity = int32(Pow2Ceil(uint32(Max(count, 4))));
+		type *newPointer = static_cast<type *>(storageType::AllocateArrayStorage(this, sizeof(type) * newCapacity));
+
+		if (elementCount != 0)
+		{
+			int32 firstCount = GetFirstSpanCount();
+			RelocateArrayElements(newPointer, ringPointer + ringHead, firstCount);
+			RelocateArrayElements(newPointer + firstCount, ringPointer, elementCount - firstCount);
+		}
+
+		if (ringCapacity > baseCount)
+		{
+			storageType::ReleaseArrayStorage(this, ringPointer, sizeof(type) * ringCapacity);
+		}
+
+		ringPointer = newPointer;
+		ringCapacity = newCapacity;
+		ringHead = 0;
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::ClearArray(void)
+	{
+		DestroyElements(0, elementCount);
+		ringHead = 0;
+		elementCount = 0;
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::PurgeArray(void)
+	{
+		DestroyElements(0, elementCount);
+
+		if (ringCapacity > baseCount)
+		{
+			storageType::ReleaseArrayStorage(this, ringPointer, sizeof(type) * ringCapacity);
+		}
+
+		ringPointer = GetBaseStorage();
+		ringCapacity = baseCount;
+		ringHead = 0;
+		elementCount = 0;
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::ReserveArrayElementCount(int32 count)
+	{
+		if (count > ringCapacity)
+		{
+			SetReservedCount(count);
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	template <typename T>
+	type *RingArray<type, baseCount, allocatorType>::AppendArrayElement(T&& element)
+	{
+		if (elementCount == ringCapacity)
+		{
+			SetReservedCount(elementCount + 1);
+		}
+
+		type *pointer = GetElementPointer(elementCount);
+		new(pointer) type(static_cast<T&&>(element));
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	template <typename T>
+	type *RingArray<type, baseCount, allocatorType>::PrependArrayElement(T&& element)
+	{
+		if (elementCount == ringCapacity)
+		{
+			SetReservedCount(elementCount + 1);
+		}
+
+		int32 head = (ringHead - 1) & (ringCapacity - 1);
+		type *pointer = &ringPointer[head];
+		new(pointer) type(static_cast<T&&>(element));
+
+		ringHead = head;
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	template <typename... T>
+	type *RingArray<type, baseCount, allocatorType>::EmplaceArrayElement(T&&... args)
+	{
+		if (elementCount == ringCapacity)
+		{
+			SetReservedCount(elementCount + 1);
+		}
+
+		type *pointer = GetElementPointer(elementCount);
+		new(pointer) type(static_cast<T&&>(args)...);
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::AppendArrayElements(const type *elements, int32 count)
+	{
+		if (count > 0)
+		{
+			int32 newCount = elementCount + count;
+			if (newCount > ringCapacity)
+			{
+				SetReservedCount(newCount);
+			}
+
+			int32 tail = (ringHead + elementCount) & (ringCapacity - 1);
+			int32 firstCount = Min(count, ringCapacity - tail);
+			CopyArrayElements(ringPointer + tail, elements, firstCount);
+			CopyArrayElements(ringPointer, elements + firstCount, count - firstCount);
+
+			elementCount = newCount;
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::RemoveFirstArrayElement(void)
+	{
+		if (elementCount > 0)
+		{
+			ringPointer[ringHead].~type();
+			ringHead = (ringHead + 1) & (ringCapacity - 1);
+			elementCount--;
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::RemoveFirstArrayElements(int32 count)
+	{
+		count = Min(count, elementCount);
+		if (count > 0)
+		{
+			for (machine a = 0; a < count; a++)
+			{
+				GetElementPointer(a)->~type();
+			}
+
+			ringHead = (ringHead + count) & (ringCapacity - 1);
+			elementCount -= count;
+		}
+	}
+
+	template <typename type, int32 baseCount, class allocatorType>
+	void RingArray<type, baseCount, allocatorType>::RemoveLastArrayElement(void)
+	{
+		if (elementCount > 0)
+		{
+			GetElementPointer(--elementCount)->~type();
+		}
+	}
+}
+
+
+#endif
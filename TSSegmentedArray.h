@@ -0,0 +1,604 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSSegmentedArray_h
+#define TSSegmentedArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_SEGMENTEDARRAY 1
+
+
+namespace Terathon
+{
+	enum
+	{
+		kMaxArraySegmentCount = 32
+	};
+
+
+	template <typename type>
+	class SegmentedArrayIterator
+	{
+		private:
+
+			type *const		*segmentTable;
+			type			*iteratorPointer;
+			type			*segmentEnd;
+			int32			segmentIndex;
+			int32			segmentBase;
+			int32			elementIndex;
+
+		public:
+
+			SegmentedArrayIterator(type *const *table, int32 base, int32 index) : segmentTable(table), segmentBase(base), elementIndex(index)
+			{
+				iteratorPointer = table[0];
+				segmentEnd = (iteratorPointer) ? iteratorPointer + base : nullptr;
+				segmentIndex = 0;
+			}
+
+			type& operator *(void) const
+			{
+				return (*iteratorPointer);
+			}
+
+			SegmentedArrayIterator& operator ++(void)
+			{
+				elementIndex++;
+				if ((++iteratorPointer == segmentEnd) && (segmentIndex < kMaxArraySegmentCount - 1))
+				{
+					type *pointer = segmentTable[++segmentIndex];
+					if (pointer)
+					{
+						iteratorPointer = pointer;
+						segmentEnd = pointer + (machine(segmentBase) << segmentIndex);
+					}
+				}
+
+				return (*this);
+			}
+
+			bool operator ==(const SegmentedArrayIterator& iterator) const
+			{
+				return (elementIndex == iterator.elementIndex);
+			}
+
+			bool operator !=(const SegmentedArrayIterator& iterator) const
+			{
+				return (elementIndex != iterator.elementIndex);
+			}
+	};
+
+
+	//# \class	SegmentedArray		A container class that holds an array of objects that never move in memory.
+	//
+	//# The $SegmentedArray$ class represents a dynamically resizable array of objects whose addresses remain
+	//# valid as the array grows.
+	//
+	//# \def	template <typename type, int32 segmentSize = 64, class allocatorType = HeapArrayAllocator> class SegmentedArray final
+	//
+	//# \tparam		type			The type of the class that can be stored in the array.
+	//# \tparam		segmentSize		The number of elements in the first segment. This must be a power of two.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the segments.
+	//
+	//# \ctor	SegmentedArray();
+	//# \ctor	explicit SegmentedArray(const allocatorType& allocator);
+	//
+	//# \param	allocator	An allocator object that is copied into the array and used for all of its storage.
+	//
+	//# \desc
+	//# The $SegmentedArray$ class template provides most of the interface of the $@Array@$ class template, but it stores its
+	//# elements in a sequence of separately allocated segments instead of a single contiguous block of memory. The first
+	//# segment holds the number of elements given by the $segmentSize$ template parameter, and each subsequent segment is
+	//# twice as large as the one before it. When the array needs more space, a new segment is allocated, and the existing
+	//# elements are never moved. Consequently, pointers to elements returned by functions such as
+	//# $@SegmentedArray::AppendArrayElement@$ remain valid until the elements they point to are removed, and growing the
+	//# array never copies the elements or needs memory for two copies of the array at once.
+	//#
+	//# Since the segment sizes form a geometric sequence, the segment containing any element can be calculated directly from
+	//# its index, and elements are accessed in constant time with the $[]$ operator. The segment table is stored inside the
+	//# $SegmentedArray$ object itself, so it never has to be reallocated either.
+	//#
+	//# Elements can only be added and removed at the end of a segmented array. The array does not release any segments when
+	//# elements are removed, so the memory can be reused, but all of the segments are released by the
+	//# $@SegmentedArray::PurgeArray@$ function.
+	//#
+	//# It is possible to iterate over the elements of a segmented array using a range-based for loop.
+	//# This is illustrated by the following code, where $array$ is a variable of type $SegmentedArray<type>$.
+	//
+	//# \source
+	//# for (type& element : array)\n
+	//# {\n
+	//# \t...\n
+	//# }
+	//
+	//# \also	$@Array@$
+
+
+	//# \function	SegmentedArray::GetArrayElementCount		Returns the current size of an array.
+	//
+	//# \proto	int32 GetArrayElementCount(void) const;
+	//
+	//# \desc
+	//# The $GetArrayElementCount$ function returns the number of elements currently stored in a segmented array.
+	//
+	//# \also	$@SegmentedArray::SetArrayElementCount@$
+	//# \also	$@SegmentedArray::GetArrayReservedCount@$
+
+
+	//# \function	SegmentedArray::GetArrayReservedCount		Returns the number of elements for which space has been allocated.
+	//
+	//# \proto	int32 GetArrayReservedCount(void) const;
+	//
+	//# \desc
+	//# The $GetArrayReservedCount$ function returns the total number of elements that the segments currently allocated
+	//# by a segmented array can hold.
+	//
+	//# \also	$@SegmentedArray::ReserveArrayElementCount@$
+
+
+	//# \function	SegmentedArray::ClearArray		Removes all elements from an array.
+	//
+	//# \proto	void ClearArray(void);
+	//
+	//# \desc
+	//# The $ClearArray$ function destroys all of the elements in a segmented array and sets its size to zero.
+	//# The segments are not released, so the array can be refilled without allocating memory.
+	//
+	//# \also	$@SegmentedArray::PurgeArray@$
+
+
+	//# \function	SegmentedArray::PurgeArray		Removes all elements from an array and deallocates its storage.
+	//
+	//# \proto	void PurgeArray(void);
+	//
+	//# \desc
+	//# The $PurgeArray$ function destroys all of the elements in a segmented array, sets its size to zero, and releases
+	//# all of its segments.
+	//
+	//# \also	$@SegmentedArray::ClearArray@$
+
+
+	//# \function	SegmentedArray::ReserveArrayElementCount		Allocates segments for a specific number of elements.
+	//
+	//# \proto	void ReserveArrayElementCount(int32 count);
+	//
+	//# \param	count	The minimum number of elements for which space is reserved.
+	//
+	//# \desc
+	//# The $ReserveArrayElementCount$ function allocates as many new segments as necessary so that the array can hold
+	//# at least the number of elements specified by the $count$ parameter. The size of the array is not changed.
+	//
+	//# \also	$@SegmentedArray::GetArrayReservedCount@$
+
+
+	//# \function	SegmentedArray::SetArrayElementCount		Sets the current size of an array.
+	//
+	//# \proto	void SetArrayElementCount(int32 count);
+	//# \proto	void SetArrayElementCount(int32 count, const type& init);
+	//
+	//# \param	count	The new size of the array.
+	//# \param	init	A reference to an object that is used to copy-construct new objects in the array.
+	//
+	//# \desc
+	//# The $SetArrayElementCount$ function sets the number of elements in a segmented array to $count$. If $count$ is
+	//# greater than the current size of the array, then new elements are default-constructed or copy-constructed from
+	//# the $init$ parameter. If $count$ is less than the current size, then the elements at the end of the array are
+	//# destroyed. Existing elements never move.
+	//
+	//# \also	$@SegmentedArray::GetArrayElementCount@$
+
+
+	//# \function	SegmentedArray::AppendArrayElement		Adds an object to the end of an array.
+	//
+	//# \proto	type *AppendArrayElement(void);
+	//# \proto	template <typename T> type *AppendArrayElement(T&& element);
+	//
+	//# \param	element		The new element to add to the array.
+	//
+	//# \desc
+	//# The $AppendArrayElement$ function increases the size of a segmented array by one and either default-constructs
+	//# the new element or initializes it with the value of the $element$ parameter. The return value is a pointer to the
+	//# new element, and it remains valid until the element is removed from the array.
+	//
+	//# \also	$@SegmentedArray::EmplaceArrayElement@$
+	//# \also	$@SegmentedArray::RemoveLastArrayElement@$
+
+
+	//# \function	SegmentedArray::EmplaceArrayElement		Constructs a new object at the end of an array.
+	//
+	//# \proto	template <typename... T> type *EmplaceArrayElement(T&&... args);
+	//
+	//# \param	args	The arguments that are forwarded to the constructor of the new element.
+	//
+	//# \desc
+	//# The $EmplaceArrayElement$ function increases the size of a segmented array by one and constructs the new element
+	//# in place by passing the arguments specified by the $args$ parameter to its constructor. The return value is a
+	//# pointer to the new element, and it remains valid until the element is removed from the array.
+	//
+	//# \also	$@SegmentedArray::AppendArrayElement@$
+
+
+	//# \function	SegmentedArray::RemoveLastArrayElement		Removes the last element in an array.
+	//
+	//# \proto	void RemoveLastArrayElement(void);
+	//
+	//# \desc
+	//# The $RemoveLastArrayElement$ function destroys the last element in a segmented array and decreases its size by one.
+	//# If the array is empty, then this function has no effect.
+	//
+	//# \also	$@SegmentedArray::AppendArrayElement@$
+
+
+	//# \function	SegmentedArray::FindArrayElementIndex		Finds a specific element in an array.
+	//
+	//# \proto	int32 FindArrayElementIndex(const type& element) const;
+	//
+	//# \param	element		The value of the element to find.
+	//
+	//# \desc
+	//# The $FindArrayElementIndex$ function searches a segmented array for the first element matching the value passed
+	//# into the $element$ parameter based on the $==$ operator. If a match is found, its index is returned. If no match
+	//# is found, then the return value is &minus;1. Each segment is searched in the same way that an $@Array@$ object is.
+
+
+	template <typename type, int32 segmentSize = 64, class allocatorType = HeapArrayAllocator>
+	class SegmentedArray final : private allocatorType
+	{
+		static_assert((segmentSize > 0) && ((segmentSize & (segmentSize - 1)) == 0), "segmentSize must be a power of two");
+
+		private:
+
+			int32		elementCount;
+			int32		segmentCount;
+
+			type		*segmentTable[kMaxArraySegmentCount];
+
+			static machine GetSegmentStart(int32 segment)
+			{
+				return ((machine(segmentSize) << segment) - segmentSize);
+			}
+
+			static machine GetSegmentCapacity(int32 segment)
+			{
+				// The last segment is cut short so that no index exceeds the range of int32.
+
+				machine start = GetSegmentStart(segment);
+				return (Min64(machine(segmentSize) << segment, machine(0x7FFFFFFF) - start));
+			}
+
+			type *GetElementPointer(int32 index) const
+			{
+				int32 segment = IntLog2(uint32(index) / segmentSize + 1);
+				return (segmentTable[segment] + (index - GetSegmentStart(segment)));
+			}
+
+			void AllocateSegment(void);
+			void DestroyElements(int32 start, int32 finish);
+
+		public:
+
+			SegmentedArray();
+			explicit SegmentedArray(const allocatorType& allocator);
+			SegmentedArray(const SegmentedArray& array);
+			SegmentedArray(SegmentedArray&& array);
+			~SegmentedArray();
+
+			SegmentedArray& operator =(const SegmentedArray&) = delete;
+
+			allocatorType& GetArrayAllocator(void)
+			{
+				return (*this);
+			}
+
+			const allocatorType& GetArrayAllocator(void) const
+			{
+				return (*this);
+			}
+
+			type& operator [](machine index)
+			{
+				return (*GetElementPointer(int32(index)));
+			}
+
+			const type& operator [](machine index) const
+			{
+				return (*GetElementPointer(int32(index)));
+			}
+
+			SegmentedArrayIterator<type> begin(void) const
+			{
+				return (SegmentedArrayIterator<type>(segmentTable, segmentSize, 0));
+			}
+
+			SegmentedArrayIterator<type> end(void) const
+			{
+				return (SegmentedArrayIterator<type>(segmentTable, segmentSize, elementCount));
+			}
+
+			bool Empty(void) const
+			{
+				return (elementCount == 0);
+			}
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (elementCount);
+			}
+
+			int32 GetArrayReservedCount(void) const
+			{
+				return (int32(Min64(GetSegmentStart(segmentCount), 0x7FFFFFFF)));
+			}
+
+			int32 FindArrayElementIndex(const type& element) const;
+
+			void ClearArray(void);
+			void PurgeArray(void);
+			void ReserveArrayElementCount(int32 count);
+
+			void SetArrayElementCount(int32 count);
+			void SetArrayElementCount(int32 count, const type& init);
+			type *AppendArrayElement(void);
+
+			template <typename T>
+			type *AppendArrayElement(T&& element);
+
+			template <typename... T>
+			type *EmplaceArrayElement(T&&... args);
+
+			void RemoveLastArrayElement(void);
+	};
+
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	SegmentedArray<type, segmentSize, allocatorType>::SegmentedArray()
+	{
+		elementCount = 0;
+		segmentCount = 0;
+
+		for (machine a = 0; a < kMaxArraySegmentCount; a++)
+		{
+			segmentTable[a] = nullptr;
+		}
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	SegmentedArray<type, segmentSize, allocatorType>::SegmentedArray(const allocatorType& allocator) : allocatorType(allocator)
+	{
+		elementCount = 0;
+		segmentCount = 0;
+
+		for (machine a = 0; a < kMaxArraySegmentCount; a++)
+		{
+			segmentTable[a] = nullptr;
+		}
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	SegmentedArray<type, segmentSize, allocatorType>::SegmentedArray(const SegmentedArray& array) : allocatorType(array)
+	{
+		elementCount = 0;
+		segmentCount = 0;
+
+		for (machine a = 0; a < kMaxArraySegmentCount; a++)
+		{
+			segmentTable[a] = nullptr;
+		}
+
+		ReserveArrayElementCount(array.elementCount);
+
+		int32 count = array.elementCount;
+		for (machine a = 0; count > 0; a++)
+		{
+			int32 copyCount = int32(Min64(GetSegmentCapacity(int32(a)), count));
+			CopyArrayElements(segmentTable[a], array.segmentTable[a], copyCount);
+			count -= copyCount;
+		}
+
+		elementCount = array.elementCount;
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	SegmentedArray<type, segmentSize, allocatorType>::SegmentedArray(SegmentedArray&& array) : allocatorType(static_cast<allocatorType&&>(array))
+	{
+		elementCount = array.elementCount;
+		segmentCount = array.segmentCount;
+
+		for (machine a = 0; a < kMaxArraySegmentCount; a++)
+		{
+			segmentTable[a] = array.segmentTable[a];
+			array.segmentTable[a] = nullptr;
+		}
+
+		array.elementCount = 0;
+		array.segmentCount = 0;
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	SegmentedArray<type, segmentSize, allocatorType>::~SegmentedArray()
+	{
+		PurgeArray();
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::AllocateSegment(void)
+	{
+		int32 segment = segmentCount;
+		segmentTable[segment] = static_cast<type *>(allocatorType::AllocateArrayStorage(sizeof(type) * GetSegmentCapacity(segment)));
+		segmentCount = segment + 1;
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::DestroyElements(int32 start, int32 finish)
+	{
+		for (machine a = finish - 1; a >= start; a--)
+		{
+			GetElementPointer(int32(a))->~type();
+		}
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	int32 SegmentedArray<type, segmentSize, allocatorType>::FindArrayElementIndex(const type& element) const
+	{
+		int32 count = elementCount;
+		for (machine a = 0; count > 0; a++)
+		{
+			int32 capacity = int32(Min64(GetSegmentCapacity(int32(a)), count));
+			machine index = ArraySearch<type>::FindArrayElement(segmentTable[a], capacity, element);
+			if (index >= 0)
+			{
+				return (int32(GetSegmentStart(int32(a)) + index));
+			}
+
+			count -= capacity;
+		}
+
+		return (-1);
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::ClearArray(void)
+	{
+		DestroyElements(0, elementCount);
+		elementCount = 0;
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::PurgeArray(void)
+	{
+		DestroyElements(0, elementCount);
+		elementCount = 0;
+
+		for (machine a = segmentCount - 1; a >= 0; a--)
+		{
+			allocatorType::ReleaseArrayStorage(segmentTable[a], sizeof(type) * GetSegmentCapacity(int32(a)));
+			segmentTable[a] = nullptr;
+		}
+
+		segmentCount = 0;
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::ReserveArrayElementCount(int32 count)
+	{
+		while (GetSegmentStart(segmentCount) < count)
+		{
+			AllocateSegment();
+		}
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::SetArrayElementCount(int32 count)
+	{
+		if (count > elementCount)
+		{
+			ReserveArrayElementCount(count);
+
+			for (machine a = elementCount; a < count; a++)
+			{
+				new(GetElementPointer(int32(a))) type;
+			}
+		}
+		else
+		{
+			DestroyElements(count, elementCount);
+		}
+
+		elementCount = count;
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::SetArrayElementCount(int32 count, const type& init)
+	{
+		if (count > elementCount)
+		{
+			ReserveArrayElementCount(count);
+
+			for (machine a = elementCount; a < count; a++)
+			{
+				new(GetElementPointer(int32(a))) type(init);
+			}
+		}
+		else
+		{
+			DestroyElements(count, elementCount);
+		}
+
+		elementCount = count;
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	type *SegmentedArray<type, segmentSize, allocatorType>::AppendArrayElement(void)
+	{
+		if (elementCount == GetSegmentStart(segmentCount))
+		{
+			AllocateSegment();
+		}
+
+		type *pointer = GetElementPointer(elementCount);
+		new(pointer) type;
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	template <typename T>
+	type *SegmentedArray<type, segmentSize, allocatorType>::AppendArrayElement(T&& element)
+	{
+		if (elementCount == GetSegmentStart(segmentCount))
+		{
+			AllocateSegment();
+		}
+
+		type *pointer = GetElementPointer(elementCount);
+		new(pointer) type(static_cast<T&&>(element));
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	template <typename... T>
+	type *SegmentedArray<type, segmentSize, allocatorType>::EmplaceArrayElement(T&&... args)
+	{
+		if (elementCount == GetSegmentStart(segmentCount))
+		{
+			AllocateSegment();
+		}
+
+		type *pointer = GetElementPointer(elementCount);
+		new(pointer) type(static_cast<T&&>(args)...);
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, int32 segmentSize, class allocatorType>
+	void SegmentedArray<type, segmentSize, allocatorType>::RemoveLastArrayElement(void)
+	{
+		int32 index = elementCount - 1;
+		if (index >= 0)
+		{
+			GetElementPointer(index)->~type();
+			elementCount = index;
+		}
+	}
+}
+
+
+#endif
@@ -0,0 +1,620 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSSharedArray_h
+#define TSSharedArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+#include "TSAtomic.h"
+
+
+#define TERATHON_SHAREDARRAY 1
+
+
+namespace Terathon
+{
+	struct SharedArrayHeader
+	{
+		volatile int32		referenceCount;
+	};
+
+
+	//# \class	SharedArray		A container class that holds an array of objects whose storage is shared by copies.
+	//
+	//# The $SharedArray$ class represents a dynamically resizable array of objects that can be copied in constant time.
+	//
+	//# \def	template <typename type, class allocatorType = HeapArrayAllocator, class growthType = DefaultArrayGrowth> class SharedArray final : public ImmutableArray<type, int32>
+	//
+	//# \tparam		type			The type of the class that can be stored in the array.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the array.
+	//# \tparam		growthType		The policy that determines how much storage is reserved when the array grows. See $@Array@$.
+	//
+	//# \ctor	SharedArray();
+	//# \ctor	explicit SharedArray(const allocatorType& allocator);
+	//# \ctor	SharedArray(const type *elements, int32 count);
+	//
+	//# \param	allocator	An allocator object that is copied into the array and used for all of its storage.
+	//# \param	elements	A pointer to elements that are copied into the new shared array.
+	//# \param	count		The number of elements to copy.
+	//
+	//# \desc
+	//# The $SharedArray$ class template provides the interface of the $@Array@$ class template, but copying a shared array
+	//# does not copy its elements. Instead, the copy refers to the same storage as the original, and the storage keeps a
+	//# reference count that is incremented and decremented atomically. The elements are copied only when a function that
+	//# modifies the array, such as $@Array::AppendArrayElement@$ or $@Array::RemoveArrayElement@$, is called for an array
+	//# whose storage is shared with another array. The array being modified then receives its own storage, and the other
+	//# arrays are not affected. This makes a shared array well suited for data that is handed to many consumers but
+	//# rarely changes.
+	//#
+	//# The elements of a shared array are read through its $@ImmutableArray@$ base class, so reading is exactly as fast as
+	//# it is for an ordinary $@Array@$ object. However, the pointer returned by the base class does not detach the storage,
+	//# so elements must not be modified through it unless the $@SharedArray::DetachArray@$ function has been called first.
+	//#
+	//# Because the reference count is atomic, copies of a shared array can be given to other threads, and each thread can
+	//# read its copy, modify it, or destroy it without synchronizing with the others. A single $SharedArray$ object must
+	//# still not be accessed by multiple threads while one of them modifies it. The storage is released by whichever copy
+	//# drops the last reference, using the allocator belonging to that copy, so the allocator should not depend on the
+	//# thread that created the array.
+	//
+	//# \base	ImmutableArray<type, int32>		The elements of a shared array are accessed through an immutable array.
+	//
+	//# \also	$@Array@$
+
+
+	//# \function	SharedArray::DetachArray		Ensures that the storage for an array is not shared.
+	//
+	//# \proto	type *DetachArray(void);
+	//
+	//# \desc
+	//# The $DetachArray$ function copies the elements of a shared array into new storage if its current storage is shared
+	//# with any other array, and it returns a pointer to the elements. The elements can then be modified through the
+	//# returned pointer until the array is copied again. If the array was not shared, then no copy is made.
+	//
+	//# \also	$@SharedArray::IsArrayShared@$
+
+
+	//# \function	SharedArray::IsArrayShared		Returns a boolean value indicating whether the storage for an array is shared.
+	//
+	//# \proto	bool IsArrayShared(void) const;
+	//
+	//# \desc
+	//# The $IsArrayShared$ function returns $true$ if the storage for a shared array is also referenced by another array,
+	//# and it returns $false$ otherwise. If other threads hold copies of the array, then the result can change at any time
+	//# from $true$ to $false$, but never from $false$ to $true$.
+	//
+	//# \also	$@SharedArray::DetachArray@$
+
+
+	template <typename type, class allocatorType = HeapArrayAllocator, class growthType = DefaultArrayGrowth>
+	class SharedArray final : private allocatorType, public ImmutableArray<type, int32>
+	{
+		private:
+
+			using ImmutableArray<type, int32>::elementCount;
+			using ImmutableArray<type, int32>::reservedCount;
+			using ImmutableArray<type, int32>::arrayPointer;
+
+			static const umachine kStorageAlignment = ArrayAlignment<type, 0>::value;
+			static const umachine kHeaderSize = (sizeof(SharedArrayHeader) + (kStorageAlignment - 1)) & ~(kStorageAlignment - 1);
+
+			typedef AlignedArrayStorage<allocatorType, kStorageAlignment> storageType;
+
+			static SharedArrayHeader *GetStorageHeader(type *pointer)
+			{
+				return (reinterpret_cast<SharedArrayHeader *>(reinterpret_cast<char *>(pointer) - kHeaderSize));
+			}
+
+			type *AllocateStorage(int32 count);
+			void FreeStorage(type *pointer, int32 count);
+			void ReleaseStorage(void);
+			void PrepareStorage(int32 count);
+
+		public:
+
+			SharedArray();
+			explicit SharedArray(const allocatorType& allocator);
+			SharedArray(const type *elements, int32 count);
+			SharedArray(const SharedArray& array);
+			SharedArray(SharedArray&& array);
+			~SharedArray();
+
+			SharedArray& operator =(const SharedArray& array);
+			SharedArray& operator =(SharedArray&& array);
+
+			allocatorType& GetArrayAllocator(void)
+			{
+				return (*this);
+			}
+
+			const allocatorType& GetArrayAllocator(void) const
+			{
+				return (*this);
+			}
+
+			int32 GetArrayReservedCount(void) const
+			{
+				return (reservedCount);
+			}
+
+			bool IsArrayShared(void) const
+			{
+				return ((arrayPointer) && (AtomicLoad(&GetStorageHeader(arrayPointer)->referenceCount) != 1));
+			}
+
+			type *DetachArray(void)
+			{
+				PrepareStorage(elementCount);
+				return (arrayPointer);
+			}
+
+			void ClearArray(void);
+			void PurgeArray(void);
+			void ReserveArrayElementCount(int32 count);
+
+			void SetArrayElementCount(int32 count);
+			void SetArrayElementCount(int32 count, const type& init);
+			type *AppendArrayElement(void);
+
+			template <typename T>
+			type *AppendArrayElement(T&& element);
+
+			template <typename T>
+			void InsertArrayElement(int32 index, T&& element);
+
+			template <typename... T>
+			type *EmplaceArrayElement(T&&... args);
+
+			void RemoveArrayElement(int32 index);
+			void RemoveLastArrayElement(void);
+
+			void AppendArrayElements(const type *elements, int32 count);
+			void InsertArrayElements(int32 index, const type *elements, int32 count);
+			void RemoveArrayElements(int32 index, int32 count);
+	};
+
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>::SharedArray()
+	{
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>::SharedArray(const allocatorType& allocator) : allocatorType(allocator)
+	{
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>::SharedArray(const type *elements, int32 count)
+	{
+		elementCount = count;
+		reservedCount = count;
+		arrayPointer = nullptr;
+
+		if (count != 0)
+		{
+			arrayPointer = AllocateStorage(count);
+			CopyArrayElements(arrayPointer, elements, count);
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>::SharedArray(const SharedArray& array) : allocatorType(array), ImmutableArray<type, int32>()
+	{
+		elementCount = array.elementCount;
+		reservedCount = array.reservedCount;
+		arrayPointer = array.arrayPointer;
+
+		if (arrayPointer)
+		{
+			AtomicAdd(&GetStorageHeader(arrayPointer)->referenceCount, 1);
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>::SharedArray(SharedArray&& array) : allocatorType(static_cast<allocatorType&&>(array))
+	{
+		elementCount = array.elementCount;
+		reservedCount = array.reservedCount;
+		arrayPointer = array.arrayPointer;
+
+		array.elementCount = 0;
+		array.reservedCount = 0;
+		array.arrayPointer = nullptr;
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>::~SharedArray()
+	{
+		ReleaseStorage();
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>& SharedArray<type, allocatorType, growthType>::operator =(const SharedArray& array)
+	{
+		if (arrayPointer != array.arrayPointer)
+		{
+			// The new reference is added before the old one is released so that assigning
+			// between copies that share the same storage can never free it.
+
+			if (array.arrayPointer)
+			{
+				AtomicAdd(&GetStorageHeader(array.arrayPointer)->referenceCount, 1);
+			}
+
+			ReleaseStorage();
+
+			allocatorType::operator =(array);
+			arrayPointer = array.arrayPointer;
+		}
+
+		elementCount = array.elementCount;
+		reservedCount = array.reservedCount;
+		return (*this);
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	SharedArray<type, allocatorType, growthType>& SharedArray<type, allocatorType, growthType>::operator =(SharedArray&& array)
+	{
+		if (this != &array)
+		{
+			ReleaseStorage();
+			allocatorType::operator =(static_cast<allocatorType&&>(array));
+
+			elementCount = array.elementCount;
+			reservedCount = array.reservedCount;
+			arrayPointer = array.arrayPointer;
+
+			array.elementCount = 0;
+			array.reservedCount = 0;
+			array.arrayPointer = nullptr;
+		}
+
+		return (*this);
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	type *SharedArray<type, allocatorType, growthType>::AllocateStorage(int32 count)
+	{
+		char *storage = static_cast<char *>(storageType::AllocateArrayStorage(this, kHeaderSize + sizeof(type) * count));
+		reinterpret_cast<SharedArrayHeader *>(storage)->referenceCount = 1;
+		return (reinterpret_cast<type *>(storage + kHeaderSize));
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::FreeStorage(type *pointer, int32 count)
+	{
+		storageType::ReleaseArrayStorage(this, GetStorageHeader(pointer), kHeaderSize + sizeof(type) * count);
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::ReleaseStorage(void)
+	{
+		// Every array sharing the storage has the same element count, so whichever one drops
+		// the last reference knows how many elements to destroy.
+
+		type *pointer = arrayPointer;
+		if ((pointer) && (AtomicAdd(&GetStorageHeader(pointer)->referenceCount, -1) == 1))
+		{
+			pointer += elementCount;
+			for (machine a = elementCount - 1; a >= 0; a--)
+			{
+				(--pointer)->~type();
+			}
+
+			FreeStorage(arrayPointer, reservedCount);
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::PrepareStorage(int32 count)
+	{
+		// Makes the storage unique to this array and large enough to hold count elements.
+
+		if (arrayPointer)
+		{
+			bool shared = (AtomicLoad(&GetStorageHeader(arrayPointer)->referenceCount) != 1);
+			if ((!shared) && (count <= reservedCount))
+			{
+				return;
+			}
+
+			int32 newReservedCount = (count > reservedCount) ? CalculateArrayReservedCount<int32, growthType>(reservedCount, count, 0, sizeof(type)) : reservedCount;
+			type *newPointer = AllocateStorage(newReservedCount);
+
+			if (shared)
+			{
+				CopyArrayElements(newPointer, arrayPointer, elementCount);
+				ReleaseStorage();
+			}
+			else
+			{
+				RelocateArrayElements(newPointer, arrayPointer, elementCount);
+				FreeStorage(arrayPointer, reservedCount);
+			}
+
+			reservedCount = newReservedCount;
+			arrayPointer = newPointer;
+		}
+		else if (count > 0)
+		{
+			reservedCount = CalculateArrayReservedCount<int32, growthType>(0, count, 0, sizeof(type));
+			arrayPointer = AllocateStorage(reservedCount);
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::ClearArray(void)
+	{
+		if (IsArrayShared())
+		{
+			ReleaseStorage();
+
+			reservedCount = 0;
+			arrayPointer = nullptr;
+		}
+		else
+		{
+			type *pointer = arrayPointer + elementCount;
+			for (machine a = elementCount - 1; a >= 0; a--)
+			{
+				(--pointer)->~type();
+			}
+		}
+
+		elementCount = 0;
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::PurgeArray(void)
+	{
+		ReleaseStorage();
+
+		elementCount = 0;
+		reservedCount = 0;
+		arrayPointer = nullptr;
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::ReserveArrayElementCount(int32 count)
+	{
+		if (count > reservedCount)
+		{
+			PrepareStorage(count);
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::SetArrayElementCount(int32 count)
+	{
+		if (count != elementCount)
+		{
+			PrepareStorage(count);
+
+			if (count > elementCount)
+			{
+				for (machine a = elementCount; a < count; a++)
+				{
+					new(&arrayPointer[a]) type;
+				}
+			}
+			else
+			{
+				for (machine a = elementCount - 1; a >= count; a--)
+				{
+					arrayPointer[a].~type();
+				}
+			}
+
+			elementCount = count;
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::SetArrayElementCount(int32 count, const type& init)
+	{
+		if (count != elementCount)
+		{
+			PrepareStorage(count);
+
+			if (count > elementCount)
+			{
+				for (machine a = elementCount; a < count; a++)
+				{
+					new(&arrayPointer[a]) type(init);
+				}
+			}
+			else
+			{
+				for (machine a = elementCount - 1; a >= count; a--)
+				{
+					arrayPointer[a].~type();
+				}
+			}
+
+			elementCount = count;
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	type *SharedArray<type, allocatorType, growthType>::AppendArrayElement(void)
+	{
+		PrepareStorage(elementCount + 1);
+
+		type *pointer = arrayPointer + elementCount;
+		new(pointer) type;
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	template <typename T>
+	type *SharedArray<type, allocatorType, growthType>::AppendArrayElement(T&& element)
+	{
+		PrepareStorage(elementCount + 1);
+
+		type *pointer = arrayPointer + elementCount;
+		new(pointer) type(static_cast<T&&>(element));
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	template <typename T>
+	void SharedArray<type, allocatorType, growthType>::InsertArrayElement(int32 index, T&& element)
+	{
+		if (index >= elementCount)
+		{
+			int32 count = index + 1;
+			PrepareStorage(count);
+
+			for (machine a = elementCount; a < index; a++)
+			{
+				new(&arrayPointer[a]) type;
+			}
+
+			new(&arrayPointer[index]) type(static_cast<T&&>(element));
+			elementCount = count;
+		}
+		else
+		{
+			PrepareStorage(elementCount + 1);
+
+			type *pointer = &arrayPointer[index];
+			RelocateArrayElements(pointer + 1, pointer, elementCount - index);
+
+			new(pointer) type(static_cast<T&&>(element));
+			elementCount++;
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	template <typename... T>
+	type *SharedArray<type, allocatorType, growthType>::EmplaceArrayElement(T&&... args)
+	{
+		PrepareStorage(elementCount + 1);
+
+		type *pointer = arrayPointer + elementCount;
+		new(pointer) type(static_cast<T&&>(args)...);
+
+		elementCount++;
+		return (pointer);
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::RemoveArrayElement(int32 index)
+	{
+		if (index < elementCount)
+		{
+			PrepareStorage(elementCount);
+
+			type *pointer = &arrayPointer[index];
+			pointer->~type();
+
+			RelocateArrayElements(pointer, pointer + 1, elementCount - index - 1);
+			elementCount--;
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::RemoveLastArrayElement(void)
+	{
+		int32 index = elementCount - 1;
+		if (index >= 0)
+		{
+			PrepareStorage(elementCount);
+
+			arrayPointer[index].~type();
+			elementCount = index;
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::AppendArrayElements(const type *elements, int32 count)
+	{
+		if (count > 0)
+		{
+			int32 newCount = elementCount + count;
+			PrepareStorage(newCount);
+
+			CopyArrayElements(arrayPointer + elementCount, elements, count);
+			elementCount = newCount;
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::InsertArrayElements(int32 index, const type *elements, int32 count)
+	{
+		if (count > 0)
+		{
+			if (index >= elementCount)
+			{
+				int32 newCount = index + count;
+				PrepareStorage(newCount);
+
+				for (machine a = elementCount; a < index; a++)
+				{
+					new(&arrayPointer[a]) type;
+				}
+
+				CopyArrayElements(arrayPointer + index, elements, count);
+				elementCount = newCount;
+			}
+			else
+			{
+				int32 newCount = elementCount + count;
+				PrepareStorage(newCount);
+
+				type *pointer = &arrayPointer[index];
+				RelocateArrayElements(pointer + count, pointer, elementCount - index);
+
+				CopyArrayElements(pointer, elements, count);
+				elementCount = newCount;
+			}
+		}
+	}
+
+	template <typename type, class allocatorType, class growthType>
+	void SharedArray<type, allocatorType, growthType>::RemoveArrayElements(int32 index, int32 count)
+	{
+		if ((index < elementCount) && (count > 0))
+		{
+			if (count > elementCount - index)
+			{
+				count = elementCount - index;
+			}
+
+			PrepareStorage(elementCount);
+
+			type *pointer = &arrayPointer[index + count];
+			for (machine a = count - 1; a >= 0; a--)
+			{
+				(--pointer)->~type();
+			}
+
+			RelocateArrayElements(pointer, pointer + count, elementCount - index - count);
+			elementCount -= count;
+		}
+	}
+}
+
+
+#endif
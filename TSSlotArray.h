@@ -0,0 +1,456 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSSlotArray_h
+#define TSSlotArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_SLOTARRAY 1
+
+
+namespace Terathon
+{
+	enum : uint32
+	{
+		kSlotHandleNone		= 0,
+		kSlotIndexNone		= 0xFFFFFFFF
+	};
+
+
+	template <typename handleType>
+	struct SlotHandleLayout;
+
+	template <>
+	struct SlotHandleLayout<uint32>
+	{
+		enum
+		{
+			kIndexBits		= 20,
+			kGenerationBits	= 12
+		};
+	};
+
+	template <>
+	struct SlotHandleLayout<uint64>
+	{
+		enum
+		{
+			kIndexBits		= 32,
+			kGenerationBits	= 32
+		};
+	};
+
+
+	struct SlotArrayEntry
+	{
+		uint32		denseIndex;
+		uint32		slotGeneration;
+	};
+
+
+	//# \class	SlotArray		A container class that holds objects identified by generational handles.
+	//
+	//# The $SlotArray$ class represents a densely packed array of objects that are referenced by handles which remain
+	//# valid when other objects are added or removed.
+	//
+	//# \def	template <typename type, typename handleType = uint32, class allocatorType = HeapArrayAllocator> class SlotArray final
+	//
+	//# \tparam		type			The type of the class that can be stored in the array.
+	//# \tparam		handleType		The type of the handles returned by the array. This must be $uint32$ or $uint64$.
+	//# \tparam		allocatorType	The allocator used to obtain storage for the array.
+	//
+	//# \ctor	SlotArray();
+	//
+	//# \desc
+	//# The $SlotArray$ class template stores objects in a contiguous array and identifies each one with a handle that does
+	//# not change for as long as the object exists. Adding an object, removing an object, and finding an object by its handle
+	//# all take constant time. When an object is removed, the last object in the array is moved into its place, so the
+	//# objects always occupy a single contiguous block of memory and can be iterated over as efficiently as an $@Array@$
+	//# object. Iterating over a slot array visits the objects in an unspecified order that changes when objects are removed.
+	//#
+	//# A handle consists of a slot index and a generation number. The slot index selects an entry in an indirection table
+	//# that records where the object currently resides in the contiguous array. Each time an object is removed, the
+	//# generation number stored in its slot is incremented, so any handle that still refers to the removed object no longer
+	//# matches, and the $@SlotArray::GetSlotElement@$ function returns $nullptr$ for it instead of returning a different
+	//# object. Slots that have been freed are placed at the end of a queue and reused in the order in which they were freed,
+	//# which maximizes the number of removals that must occur before the same handle value could be produced again.
+	//#
+	//# For 32-bit handles, the low 20 bits hold the slot index, and the high 12 bits hold the generation number. For 64-bit
+	//# handles, each part has 32 bits. The generation number is never zero, so a handle value of zero, given by the constant
+	//# $kSlotHandleNone$, never refers to an object.
+	//#
+	//# It is possible to iterate over the objects in a slot array using a range-based for loop.
+	//# This is illustrated by the following code, where $array$ is a variable of type $SlotArray<type>$.
+	//
+	//# \source
+	//# for (type& element : array)\n
+	//# {\n
+	//# \t...\n
+	//# }
+	//
+	//# \also	$@Array@$
+
+
+	//# \function	SlotArray::InsertSlotElement		Adds an object to an array and returns its handle.
+	//
+	//# \proto	template <typename T> handleType InsertSlotElement(T&& element);
+	//
+	//# \param	element		The new element to add to the array.
+	//
+	//# \desc
+	//# The $InsertSlotElement$ function adds a new element to a slot array, initializes it with the value of the $element$
+	//# parameter, and returns the handle that identifies it. If all possible slot indexes are in use, then no element is
+	//# added, and the return value is $kSlotHandleNone$.
+	//
+	//# \also	$@SlotArray::EmplaceSlotElement@$
+	//# \also	$@SlotArray::RemoveSlotElement@$
+
+
+	//# \function	SlotArray::EmplaceSlotElement		Constructs a new object in an array and returns its handle.
+	//
+	//# \proto	template <typename... T> handleType EmplaceSlotElement(T&&... args);
+	//
+	//# \param	args	The arguments that are forwarded to the constructor of the new element.
+	//
+	//# \desc
+	//# The $EmplaceSlotElement$ function adds a new element to a slot array, constructs it in place by passing the arguments
+	//# specified by the $args$ parameter to its constructor, and returns the handle that identifies it. If all possible slot
+	//# indexes are in use, then no element is added, and the return value is $kSlotHandleNone$.
+	//
+	//# \also	$@SlotArray::InsertSlotElement@$
+
+
+	//# \function	SlotArray::RemoveSlotElement		Removes the object identified by a handle.
+	//
+	//# \proto	bool RemoveSlotElement(handleType handle);
+	//
+	//# \param	handle	The handle of the element to remove.
+	//
+	//# \desc
+	//# The $RemoveSlotElement$ function destroys the element identified by the $handle$ parameter and invalidates the handle.
+	//# The last element in the contiguous array is moved into the position previously occupied by the removed element, so
+	//# the type of the elements must be move-assignable. If the handle does not refer to an element in the array, then the
+	//# array is not modified, and the return value is $false$. Otherwise, the return value is $true$.
+	//
+	//# \also	$@SlotArray::InsertSlotElement@$
+
+
+	//# \function	SlotArray::GetSlotElement		Returns the object identified by a handle.
+	//
+	//# \proto	type *GetSlotElement(handleType handle) const;
+	//
+	//# \param	handle	The handle of the element to return.
+	//
+	//# \desc
+	//# The $GetSlotElement$ function returns a pointer to the element identified by the $handle$ parameter. If the element
+	//# has been removed, or the handle was never returned by the array, then the return value is $nullptr$. The returned
+	//# pointer remains valid only until the next element is added to or removed from the array, but the handle itself
+	//# remains valid until its element is removed.
+	//
+	//# \also	$@SlotArray::GetSlotHandle@$
+
+
+	//# \function	SlotArray::GetSlotHandle		Returns the handle of the object at a specific position.
+	//
+	//# \proto	handleType GetSlotHandle(int32 index) const;
+	//
+	//# \param	index	The position of the element in the contiguous array.
+	//
+	//# \desc
+	//# The $GetSlotHandle$ function returns the handle of the element stored at the position specified by the $index$
+	//# parameter, which is the same position used by the $[]$ operator. This can be used to recover the handles of the
+	//# elements while iterating over the array.
+	//
+	//# \also	$@SlotArray::GetSlotElement@$
+
+
+	template <typename type, typename handleType = uint32, class allocatorType = HeapArrayAllocator>
+	class SlotArray final
+	{
+		private:
+
+			enum : handleType
+			{
+				kIndexBits			= SlotHandleLayout<handleType>::kIndexBits,
+				kIndexMask			= (handleType(1) << kIndexBits) - 1,
+				kGenerationMask		= handleType(~handleType(0)) >> kIndexBits,
+				kMaxSlotCount		= (kIndexMask < 0x7FFFFFFF) ? kIndexMask : 0x7FFFFFFF
+			};
+
+			Array<type, 0, allocatorType>				elementArray;
+			Array<handleType, 0, allocatorType>			handleArray;
+			Array<SlotArrayEntry, 0, allocatorType>		slotArray;
+
+			uint32		freeSlotHead;
+			uint32		freeSlotTail;
+
+			static handleType MakeSlotHandle(uint32 index, uint32 generation)
+			{
+				return ((handleType(generation) << kIndexBits) | index);
+			}
+
+			const SlotArrayEntry *FindSlotEntry(handleType handle) const
+			{
+				// A free slot stores the index of the next free slot in place of its dense index, so the
+				// handle recorded at the dense position is compared to confirm that the slot is in use.
+
+				uint32 index = uint32(handle & kIndexMask);
+				if (index < uint32(slotArray.GetArrayElementCount()))
+				{
+					const SlotArrayEntry *entry = &slotArray[index];
+					uint32 denseIndex = entry->denseIndex;
+					if ((denseIndex < uint32(handleArray.GetArrayElementCount())) && (handleArray[denseIndex] == handle))
+					{
+						return (entry);
+					}
+				}
+
+				return (nullptr);
+			}
+
+			handleType AllocateSlot(void);
+
+		public:
+
+			SlotArray();
+
+			type& operator [](machine index)
+			{
+				return (elementArray[index]);
+			}
+
+			const type& operator [](machine index) const
+			{
+				return (elementArray[index]);
+			}
+
+			type *begin(void) const
+			{
+				return (elementArray.begin());
+			}
+
+			type *end(void) const
+			{
+				return (elementArray.end());
+			}
+
+			bool Empty(void) const
+			{
+				return (elementArray.Empty());
+			}
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (elementArray.GetArrayElementCount());
+			}
+
+			handleType GetSlotHandle(int32 index) const
+			{
+				return (handleArray[index]);
+			}
+
+			bool ValidSlotHandle(handleType handle) const
+			{
+				return (FindSlotEntry(handle) != nullptr);
+			}
+
+			type *GetSlotElement(handleType handle) const
+			{
+				const SlotArrayEntry *entry = FindSlotEntry(handle);
+				return ((entry) ? &elementArray[entry->denseIndex] : nullptr);
+			}
+
+			void ClearArray(void);
+			void PurgeArray(void);
+			void ReserveArrayElementCount(int32 count);
+
+			template <typename T>
+			handleType InsertSlotElement(T&& element);
+
+			template <typename... T>
+			handleType EmplaceSlotElement(T&&... args);
+
+			bool RemoveSlotElement(handleType handle);
+	};
+
+
+	template <typename type, typename handleType, class allocatorType>
+	SlotArray<type, handleType, allocatorType>::SlotArray()
+	{
+		freeSlotHead = kSlotIndexNone;
+		freeSlotTail = kSlotIndexNone;
+	}
+
+	template <typename type, typename handleType, class allocatorType>
+	handleType SlotArray<type, handleType, allocatorType>::AllocateSlot(void)
+	{
+		// Returns a handle for an unused slot whose dense index has been set to the position
+		// of the element about to be appended, or kSlotHandleNone if no slot is available.
+
+		uint32 index = freeSlotHead;
+		SlotArrayEntry *entry;
+
+		if (index != kSlotIndexNone)
+		{
+			entry = &slotArray[index];
+			freeSlotHead = entry->denseIndex;
+			if (freeSlotHead == kSlotIndexNone)
+			{
+				freeSlotTail = kSlotIndexNone;
+			}
+		}
+		else
+		{
+			index = uint32(slotArray.GetArrayElementCount());
+			if (index >= kMaxSlotCount)
+			{
+				return (kSlotHandleNone);
+			}
+
+			entry = slotArray.AppendArrayElement();
+			entry->slotGeneration = 1;
+		}
+
+		int32 denseIndex = elementArray.GetArrayElementCount();
+		entry->denseIndex = denseIndex;
+
+		handleType handle = MakeSlotHandle(index, entry->slotGeneration);
+		handleArray.AppendArrayElement(handle);
+		return (handle);
+	}
+
+	template <typename type, typename handleType, class allocatorType>
+	void SlotArray<type, handleType, allocatorType>::ClearArray(void)
+	{
+		// Every slot in use is freed so that outstanding handles become invalid.
+
+		int32 count = handleArray.GetArrayElementCount();
+		for (machine a = 0; a < count; a++)
+		{
+			uint32 index = uint32(handleArray[a] & kIndexMask);
+			SlotArrayEntry *entry = &slotArray[index];
+
+			uint32 generation = (entry->slotGeneration + 1) & uint32(kGenerationMask);
+			entry->slotGeneration = (generation != 0) ? generation : 1;
+			entry->denseIndex = kSlotIndexNone;
+
+			if (freeSlotTail != kSlotIndexNone)
+			{
+				slotArray[freeSlotTail].denseIndex = index;
+			}
+			else
+			{
+				freeSlotHead = index;
+			}
+
+			freeSlotTail = index;
+		}
+
+		elementArray.ClearArray();
+		handleArray.ClearArray();
+	}
+
+	template <typename type, typename handleType, class allocatorType>
+	void SlotArray<type, handleType, allocatorType>::PurgeArray(void)
+	{
+		elementArray.PurgeArray();
+		handleArray.PurgeArray();
+		slotArray.PurgeArray();
+
+		freeSlotHead = kSlotIndexNone;
+		freeSlotTail = kSlotIndexNone;
+	}
+
+	template <typename type, typename handleType, class allocatorType>
+	void SlotArray<type, handleType, allocatorType>::ReserveArrayElementCount(int32 count)
+	{
+		elementArray.ReserveArrayElementCount(count);
+		handleArray.ReserveArrayElementCount(count);
+		slotArray.ReserveArrayElementCount(count);
+	}
+
+	template <typename type, typename handleType, class allocatorType>
+	template <typename T>
+	handleType SlotArray<type, handleType, allocatorType>::InsertSlotElement(T&& element)
+	{
+		handleType handle = AllocateSlot();
+		if (handle != kSlotHandleNone)
+		{
+			elementArray.AppendArrayElement(static_cast<T&&>(element));
+		}
+
+		return (handle);
+	}
+
+	template <typename type, typename handleType, class allocatorType>
+	template <typename... T>
+	handleType SlotArray<type, handleType, allocatorType>::EmplaceSlotElement(T&&... args)
+	{
+		handleType handle = AllocateSlot();
+		if (handle != kSlotHandleNone)
+		{
+			elementArray.EmplaceArrayElement(static_cast<T&&>(args)...);
+		}
+
+		return (handle);
+	}
+
+	template <typename type, typename handleType, class allocatorType>
+	bool SlotArray<type, handleType, allocatorType>::RemoveSlotElement(handleType handle)
+	{
+		SlotArrayEntry *entry = const_cast<SlotArrayEntry *>(FindSlotEntry(handle));
+		if (!entry)
+		{
+			return (false);
+		}
+
+		// The last element is moved into the hole left by the removed element, and the slot
+		// that refers to it is updated with its new position.
+
+		uint32 denseIndex = entry->denseIndex;
+		int32 lastIndex = elementArray.GetArrayElementCount() - 1;
+		if (int32(denseIndex) != lastIndex)
+		{
+			handleType lastHandle = handleArray[lastIndex];
+			elementArray[denseIndex] = static_cast<type&&>(elementArray[lastIndex]);
+			handleArray[denseIndex] = lastHandle;
+			slotArray[lastHandle & kIndexMask].denseIndex = denseIndex;
+		}
+
+		elementArray.RemoveLastArrayElement();
+		handleArray.RemoveLastArrayElement();
+
+		uint32 generation = (entry->slotGeneration + 1) & uint32(kGenerationMask);
+		entry->slotGeneration = (generation != 0) ? generation : 1;
+		entry->denseIndex = kSlotIndexNone;
+
+		uint32 index = uint32(handle & kIndexMask);
+		if (freeSlotTail != kSlotIndexNone)
+		{
+			slotArray[freeSlotTail].denseIndex = index;
+		}
+		else
+		{
+			freeSlotHead = index;
+		}
+
+		freeSlotTail = index;
+		return (true);
+	}
+}
+
+
+#endif
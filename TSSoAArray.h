@@ -0,0 +1,677 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSSoAArray_h
+#define TSSoAArray_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_SOAARRAY 1
+
+
+namespace Terathon
+{
+	enum
+	{
+		kSoAColumnAlignment = 64
+	};
+
+
+	template <int32 index, typename type, typename... types>
+	struct SoAColumnType
+	{
+		typedef typename SoAColumnType<index - 1, types...>::columnType columnType;
+	};
+
+	template <typename type, typename... types>
+	struct SoAColumnType<0, type, types...>
+	{
+		typedef type columnType;
+	};
+
+
+	template <typename... types>
+	struct SoAColumnList
+	{
+		// This is the end of the recursion over the column types. Each function in the
+		// specialization below handles the first column and then passes the rest on.
+
+		static const umachine kElementSize = 0;
+
+		static umachine GetStorageSize(umachine /*count*/)
+		{
+			return (0);
+		}
+
+		static void SetColumnPointers(char ** /*pointer*/, char * /*storage*/, umachine /*count*/) {}
+		static void RelocateColumns(char ** /*dest*/, char *const * /*source*/, machine /*count*/) {}
+		static void CopyColumns(char ** /*dest*/, char *const * /*source*/, machine /*count*/) {}
+		static void MoveElement(char ** /*pointer*/, machine /*dest*/, machine /*source*/) {}
+		static void ShiftElements(char ** /*pointer*/, machine /*index*/, machine /*count*/) {}
+		static void ConstructElements(char ** /*pointer*/, machine /*index*/, machine /*count*/) {}
+		static void ConstructElement(char ** /*pointer*/, machine /*index*/) {}
+		static void DestroyElements(char ** /*pointer*/, machine /*index*/, machine /*count*/) {}
+	};
+
+	template <typename type, typename... types>
+	struct SoAColumnList<type, types...>
+	{
+		typedef SoAColumnList<types...> nextList;
+
+		static const umachine kElementSize = sizeof(type) + nextList::kElementSize;
+
+		static umachine GetColumnSize(umachine count)
+		{
+			return ((sizeof(type) * count + (kSoAColumnAlignment - 1)) & ~umachine(kSoAColumnAlignment - 1));
+		}
+
+		static umachine GetStorageSize(umachine count)
+		{
+			return (GetColumnSize(count) + nextList::GetStorageSize(count));
+		}
+
+		static void SetColumnPointers(char **pointer, char *storage, umachine count)
+		{
+			pointer[0] = storage;
+			nextList::SetColumnPointers(pointer + 1, storage + GetColumnSize(count), count);
+		}
+
+		static void RelocateColumns(char **dest, char *const *source, machine count)
+		{
+			RelocateArrayElements(reinterpret_cast<type *>(dest[0]), reinterpret_cast<type *>(source[0]), count);
+			nextList::RelocateColumns(dest + 1, source + 1, count);
+		}
+
+		static void CopyColumns(char **dest, char *const *source, machine count)
+		{
+			CopyArrayElements(reinterpret_cast<type *>(dest[0]), reinterpret_cast<const type *>(source[0]), count);
+			nextList::CopyColumns(dest + 1, source + 1, count);
+		}
+
+		static void MoveElement(char **pointer, machine dest, machine source)
+		{
+			type *column = reinterpret_cast<type *>(pointer[0]);
+			RelocateArrayElements(column + dest, column + source, 1);
+			nextList::MoveElement(pointer + 1, dest, source);
+		}
+
+		static void ShiftElements(char **pointer, machine index, machine count)
+		{
+			type *column = reinterpret_cast<type *>(pointer[0]);
+			RelocateArrayElements(column + index, column + (index + 1), count);
+			nextList::ShiftElements(pointer + 1, index, count);
+		}
+
+		static void ConstructElements(char **pointer, machine index, machine count)
+		{
+			type *column = reinterpret_cast<type *>(pointer[0]);
+			for (machine a = 0; a < count; a++)
+			{
+				new(&column[index + a]) type;
+			}
+
+			nextList::ConstructElements(pointer + 1, index, count);
+		}
+
+		template <typename T, typename... U>
+		static void ConstructElement(char **pointer, machine index, T&& element, U&&... elements)
+		{
+			new(&reinterpret_cast<type *>(pointer[0])[index]) type(static_cast<T&&>(element));
+			nextList::ConstructElement(pointer + 1, index, static_cast<U&&>(elements)...);
+		}
+
+		static void DestroyElements(char **pointer, machine index, machine count)
+		{
+			type *column = reinterpret_cast<type *>(pointer[0]);
+			for (machine a = index + count - 1; a >= index; a--)
+			{
+				column[a].~type();
+			}
+
+			nextList::DestroyElements(pointer + 1, index, count);
+		}
+	};
+
+
+	//# \class	SoAArrayColumn		A view of one column of a structure-of-arrays container.
+	//
+	//# The $SoAArrayColumn$ class provides access to the elements of one column of an $@SoAArray@$ object.
+	//
+	//# \def	template <typename type> class SoAArrayColumn final : public ImmutableArray<type, int32>
+	//
+	//# \tparam		type	The type of the elements stored in the column.
+	//
+	//# \desc
+	//# An $SoAArrayColumn$ object is returned by the $@SoAArray::GetArrayColumn@$ function. It has the same interface
+	//# as the $@ImmutableArray@$ class, so it can be converted to a pointer to the first element of the column, and it
+	//# can be used in a range-based for loop. The elements of the column can be modified through the view, but the
+	//# number of elements cannot be changed.
+	//#
+	//# The view is invalidated when elements are added to or removed from the $@SoAArray@$ object that returned it.
+	//
+	//# \base	ImmutableArray<type, int32>		The view provides read-only access to the size of the column.
+	//
+	//# \also	$@SoAArray@$
+
+
+	template <typename type>
+	class SoAArrayColumn final : public ImmutableArray<type, int32>
+	{
+		public:
+
+			SoAArrayColumn(type *pointer, int32 count, int32 reserved)
+			{
+				this->elementCount = count;
+				this->reservedCount = reserved;
+				this->arrayPointer = pointer;
+			}
+
+			SoAArrayColumn(const SoAArrayColumn& column)
+			{
+				this->elementCount = column.elementCount;
+				this->reservedCount = column.reservedCount;
+				this->arrayPointer = column.arrayPointer;
+			}
+
+			type& operator [](machine index) const
+			{
+				return (this->arrayPointer[index]);
+			}
+	};
+
+
+	//# \class	SoAArray		A container class that holds a structure of arrays.
+	//
+	//# The $SoAArray$ class represents a dynamically resizable array of records whose fields are stored in separate arrays.
+	//
+	//# \def	template <typename... types> class SoAArray final
+	//
+	//# \tparam		types	The types of the fields in each record. Each type corresponds to one column of the array.
+	//
+	//# \ctor	SoAArray();
+	//
+	//# \desc
+	//# The $SoAArray$ class template stores each field of its records in a separate column so that all of the values of
+	//# one field are contiguous in memory. Code that processes only some of the fields, such as a vectorized loop that
+	//# updates positions from velocities, then reads only the columns it needs and doesn't bring the other fields into
+	//# the cache. In contrast, an $@Array@$ object holding structures interleaves all of the fields of each element.
+	//#
+	//# All of the columns share one element count, and they are kept in sync by every function that adds or removes
+	//# elements. The columns are stored in a single block of memory allocated by the $@HeapArrayAllocator@$ class, so
+	//# growing the array performs one allocation regardless of the number of columns. Each column begins on a
+	//# 64-byte boundary and its storage is padded to a multiple of 64 bytes, so vectorized code can use aligned loads
+	//# and stores starting at the first element of any column. The reserved count grows according to the
+	//# $@DefaultArrayGrowth@$ policy, and elements are moved with a single $memmove$ operation per column when they
+	//# are trivially relocatable (see $@TriviallyRelocatable@$).
+	//#
+	//# A column is accessed by passing its index as the template argument of the $@SoAArray::GetArrayColumn@$ function.
+	//# This is illustrated by the following code, which declares an array of positions and velocities.
+	//
+	//# \source
+	//# SoAArray<Point3D, Vector3D> particleArray;\n
+	//# particleArray.AppendArrayElement(Point3D(0.0F, 0.0F, 0.0F), Vector3D(1.0F, 0.0F, 0.0F));\n\n
+	//# Point3D *position = particleArray.GetArrayColumn<0>();\n
+	//# const Vector3D *velocity = particleArray.GetArrayColumn<1>();
+	//
+	//# \also	$@SoAArrayColumn@$
+	//# \also	$@Array@$
+
+
+	//# \function	SoAArray::GetArrayElementCount		Returns the current size of an array.
+	//
+	//# \proto	int32 GetArrayElementCount(void) const;
+	//
+	//# \desc
+	//# The $GetArrayElementCount$ function returns the number of records currently stored in a structure-of-arrays
+	//# container. Every column holds this number of elements.
+	//
+	//# \also	$@SoAArray::SetArrayElementCount@$
+
+
+	//# \function	SoAArray::GetArrayColumn		Returns a view of one column of an array.
+	//
+	//# \proto	template <int32 index> SoAArrayColumn<columnType> GetArrayColumn(void) const;
+	//
+	//# \tparam		index	The index of the column, corresponding to a position in the $types$ template parameter list.
+	//
+	//# \desc
+	//# The $GetArrayColumn$ function returns an $@SoAArrayColumn@$ object that refers to the elements of the column
+	//# specified by the $index$ template parameter. The type of the elements in the column is the type at position
+	//# $index$ in the $types$ template parameter list of the $SoAArray$ class. If the array is empty and no storage
+	//# has been allocated, then the view contains a null pointer.
+	//
+	//# \also	$@SoAArrayColumn@$
+
+
+	//# \function	SoAArray::AppendArrayElement		Adds a record to the end of an array.
+	//
+	//# \proto	template <typename... T> int32 AppendArrayElement(T&&... elements);
+	//
+	//# \param	elements	The values of the fields of the new record. There must be one value for each column.
+	//
+	//# \desc
+	//# The $AppendArrayElement$ function increases the size of an array by one and constructs the new element in each
+	//# column using the corresponding value in the $elements$ parameter. The return value is the index of the new record.
+	//
+	//# \also	$@SoAArray::SetArrayElementCount@$
+	//# \also	$@SoAArray::RemoveArrayElement@$
+
+
+	//# \function	SoAArray::SetArrayElementCount		Sets the current size of an array.
+	//
+	//# \proto	void SetArrayElementCount(int32 count);
+	//
+	//# \param	count	The new size of the array.
+	//
+	//# \desc
+	//# The $SetArrayElementCount$ function sets the number of records stored in an array. If the array grows, then the new
+	//# elements of every column are default-constructed. If the array shrinks, then the elements beyond the new size are
+	//# destroyed in every column.
+	//
+	//# \also	$@SoAArray::GetArrayElementCount@$
+	//# \also	$@SoAArray::AppendArrayElement@$
+
+
+	//# \function	SoAArray::RemoveArrayElement		Removes a record from an array.
+	//
+	//# \proto	void RemoveArrayElement(int32 index);
+	//
+	//# \param	index	The index of the record to remove.
+	//
+	//# \desc
+	//# The $RemoveArrayElement$ function destroys the record at location $index$ in every column and moves all of the
+	//# records following it down by one, preserving their order. If the $index$ parameter is greater than or equal to
+	//# the current size of the array, then calling the $RemoveArrayElement$ function has no effect.
+	//
+	//# \also	$@SoAArray::RemoveArrayElementUnordered@$
+	//# \also	$@SoAArray::RemoveLastArrayElement@$
+
+
+	//# \function	SoAArray::RemoveArrayElementUnordered		Removes a record from an array without preserving order.
+	//
+	//# \proto	void RemoveArrayElementUnordered(int32 index);
+	//
+	//# \param	index	The index of the record to remove.
+	//
+	//# \desc
+	//# The $RemoveArrayElementUnordered$ function destroys the record at location $index$ in every column and moves the
+	//# last record of the array into the vacated location, so only one element per column is moved. If the $index$
+	//# parameter is greater than or equal to the current size of the array, then calling the $RemoveArrayElementUnordered$
+	//# function has no effect.
+	//
+	//# \also	$@SoAArray::RemoveArrayElement@$
+	//# \also	$@SoAArray::RemoveLastArrayElement@$
+
+
+	//# \function	SoAArray::RemoveLastArrayElement		Removes the last record from an array.
+	//
+	//# \proto	void RemoveLastArrayElement(void);
+	//
+	//# \desc
+	//# The $RemoveLastArrayElement$ function destroys the last record of an array in every column. If the array is empty,
+	//# then calling the $RemoveLastArrayElement$ function has no effect.
+	//
+	//# \also	$@SoAArray::RemoveArrayElement@$
+
+
+	//# \function	SoAArray::ClearArray		Removes all records from an array.
+	//
+	//# \proto	void ClearArray(void);
+	//
+	//# \desc
+	//# The $ClearArray$ function destroys all of the elements in every column of an array and sets its size to zero.
+	//# The storage allocated by the array is retained.
+	//
+	//# \also	$@SoAArray::PurgeArray@$
+
+
+	//# \function	SoAArray::PurgeArray		Removes all records from an array and deallocates its storage.
+	//
+	//# \proto	void PurgeArray(void);
+	//
+	//# \desc
+	//# The $PurgeArray$ function destroys all of the elements in every column of an array, sets its size to zero, and
+	//# releases the storage that was allocated for the array.
+	//
+	//# \also	$@SoAArray::ClearArray@$
+
+
+	//# \function	SoAArray::ReserveArrayElementCount		Allocates storage for a specific number of records.
+	//
+	//# \proto	void ReserveArrayElementCount(int32 count);
+	//
+	//# \param	count	The number of records for which storage is reserved.
+	//
+	//# \desc
+	//# The $ReserveArrayElementCount$ function ensures that every column of an array has storage for at least $count$
+	//# elements. If the array already has enough storage, then this function has no effect.
+	//
+	//# \also	$@SoAArray::GetArrayReservedCount@$
+
+
+	template <typename... types>
+	class SoAArray final : private HeapArrayAllocator
+	{
+		static_assert(sizeof...(types) != 0, "SoAArray must have at least one column");
+
+		private:
+
+			typedef SoAColumnList<types...> columnList;
+			typedef AlignedArrayStorage<HeapArrayAllocator, kSoAColumnAlignment> storageType;
+
+			static const int32 kColumnCount = int32(sizeof...(types));
+
+			int32		elementCount;
+			int32		reservedCount;
+
+			char		*columnPointer[kColumnCount];
+
+			void SetReservedCount(int32 count);
+
+		public:
+
+			SoAArray();
+			SoAArray(const SoAArray& array);
+			SoAArray(SoAArray&& array);
+			~SoAArray();
+
+			SoAArray& operator =(const SoAArray& array);
+			SoAArray& operator =(SoAArray&& array);
+
+			bool Empty(void) const
+			{
+				return (elementCount == 0);
+			}
+
+			int32 GetArrayElementCount(void) const
+			{
+				return (elementCount);
+			}
+
+			int32 GetArrayReservedCount(void) const
+			{
+				return (reservedCount);
+			}
+
+			template <int32 index>
+			SoAArrayColumn<typename SoAColumnType<index, types...>::columnType> GetArrayColumn(void) const
+			{
+				static_assert((index >= 0) && (index < kColumnCount), "Column index out of range");
+
+				typedef typename SoAColumnType<index, types...>::columnType columnType;
+				return (SoAArrayColumn<columnType>(reinterpret_cast<columnType *>(columnPointer[index]), elementCount, reservedCount));
+			}
+
+			void ClearArray(void);
+			void PurgeArray(void);
+			void ReserveArrayElementCount(int32 count);
+			void SetArrayElementCount(int32 count);
+
+			template <typename... T>
+			int32 AppendArrayElement(T&&... elements);
+
+			void RemoveArrayElement(int32 index);
+			void RemoveArrayElementUnordered(int32 index);
+			void RemoveLastArrayElement(void);
+	};
+
+
+	template <typename... types>
+	SoAArray<types...>::SoAArray()
+	{
+		elementCount = 0;
+		reservedCount = 0;
+
+		for (machine a = 0; a < kColumnCount; a++)
+		{
+			columnPointer[a] = nullptr;
+		}
+	}
+
+	template <typename... types>
+	SoAArray<types...>::SoAArray(const SoAArray& array)
+	{
+		elementCount = 0;
+		reservedCount = 0;
+
+		for (machine a = 0; a < kColumnCount; a++)
+		{
+			columnPointer[a] = nullptr;
+		}
+
+		int32 count = array.elementCount;
+		if (count != 0)
+		{
+			SetReservedCount(count);
+			columnList::CopyColumns(columnPointer, array.columnPointer, count);
+			elementCount = count;
+		}
+	}
+
+	template <typename... types>
+	SoAArray<types...>::SoAArray(SoAArray&& array)
+	{
+		elementCount = array.elementCount;
+		reservedCount = array.reservedCount;
+
+		for (machine a = 0; a < kColumnCount; a++)
+		{
+			columnPointer[a] = array.columnPointer[a];
+			array.columnPointer[a] = nullptr;
+		}
+
+		array.elementCount = 0;
+		array.reservedCount = 0;
+	}
+
+	template <typename... types>
+	SoAArray<types...>::~SoAArray()
+	{
+		PurgeArray();
+	}
+
+	template <typename... types>
+	SoAArray<types...>& SoAArray<types...>::operator =(const SoAArray& array)
+	{
+		if (this != &array)
+		{
+			ClearArray();
+
+			int32 count = array.elementCount;
+			if (count != 0)
+			{
+				if (count > reservedCount)
+				{
+					SetReservedCount(count);
+				}
+
+				columnList::CopyColumns(columnPointer, array.columnPointer, count);
+				elementCount = count;
+			}
+		}
+
+		return (*this);
+	}
+
+	template <typename... types>
+	SoAArray<types...>& SoAArray<types...>::operator =(SoAArray&& array)
+	{
+		if (this != &array)
+		{
+			PurgeArray();
+
+			elementCount = array.elementCount;
+			reservedCount = array.reservedCount;
+
+			for (machine a = 0; a < kColumnCount; a++)
+			{
+				columnPointer[a] = array.columnPointer[a];
+				array.columnPointer[a] = nullptr;
+			}
+
+			array.elementCount = 0;
+			array.reservedCount = 0;
+		}
+
+		return (*this);
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::SetReservedCount(int32 count)
+	{
+		// All of the columns live in one block, so the whole block is replaced and each column
+		// is relocated into its new position. The columns can't be extended in place because
+		// every column except the last would have to move anyway.
+
+		int32 newReservedCount = CalculateArrayReservedCount<int32, DefaultArrayGrowth>(reservedCount, count, 4, columnList::kElementSize);
+
+		char	*newPointer[kColumnCount];
+
+		char *storage = static_cast<char *>(storageType::AllocateArrayStorage(this, columnList::GetStorageSize(newReservedCount)));
+		columnList::SetColumnPointers(newPointer, storage, newReservedCount);
+
+		if (reservedCount != 0)
+		{
+			if (elementCount != 0)
+			{
+				columnList::RelocateColumns(newPointer, columnPointer, elementCount);
+			}
+
+			storageType::ReleaseArrayStorage(this, columnPointer[0], columnList::GetStorageSize(reservedCount));
+		}
+
+		for (machine a = 0; a < kColumnCount; a++)
+		{
+			columnPointer[a] = newPointer[a];
+		}
+
+		reservedCount = newReservedCount;
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::ClearArray(void)
+	{
+		if (elementCount != 0)
+		{
+			columnList::DestroyElements(columnPointer, 0, elementCount);
+			elementCount = 0;
+		}
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::PurgeArray(void)
+	{
+		ClearArray();
+
+		if (reservedCount != 0)
+		{
+			storageType::ReleaseArrayStorage(this, columnPointer[0], columnList::GetStorageSize(reservedCount));
+			reservedCount = 0;
+
+			for (machine a = 0; a < kColumnCount; a++)
+			{
+				columnPointer[a] = nullptr;
+			}
+		}
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::ReserveArrayElementCount(int32 count)
+	{
+		if (count > reservedCount)
+		{
+			SetReservedCount(count);
+		}
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::SetArrayElementCount(int32 count)
+	{
+		if (count > elementCount)
+		{
+			if (count > reservedCount)
+			{
+				SetReservedCount(count);
+			}
+
+			columnList::ConstructElements(columnPointer, elementCount, count - elementCount);
+			elementCount = count;
+		}
+		else if (count < elementCount)
+		{
+			columnList::DestroyElements(columnPointer, count, elementCount - count);
+			elementCount = count;
+		}
+	}
+
+	template <typename... types>
+	template <typename... T>
+	int32 SoAArray<types...>::AppendArrayElement(T&&... elements)
+	{
+		static_assert(sizeof...(T) == sizeof...(types), "AppendArrayElement requires one value for each column");
+
+		int32 index = elementCount;
+		if (index >= reservedCount)
+		{
+			SetReservedCount(index + 1);
+		}
+
+		columnList::ConstructElement(columnPointer, index, static_cast<T&&>(elements)...);
+		elementCount = index + 1;
+		return (index);
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::RemoveArrayElement(int32 index)
+	{
+		if (index < elementCount)
+		{
+			columnList::DestroyElements(columnPointer, index, 1);
+			columnList::ShiftElements(columnPointer, index, elementCount - index - 1);
+			elementCount--;
+		}
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::RemoveArrayElementUnordered(int32 index)
+	{
+		if (index < elementCount)
+		{
+			columnList::DestroyElements(columnPointer, index, 1);
+
+			int32 last = elementCount - 1;
+			if (index != last)
+			{
+				columnList::MoveElement(columnPointer, index, last);
+			}
+
+			elementCount = last;
+		}
+	}
+
+	template <typename... types>
+	void SoAArray<types...>::RemoveLastArrayElement(void)
+	{
+		int32 index = elementCount - 1;
+		if (index >= 0)
+		{
+			columnList::DestroyElements(columnPointer, index, 1);
+			elementCount = index;
+		}
+	}
+}
+
+
+#endif
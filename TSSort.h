@@ -0,0 +1,904 @@
+//
+// This file is part of the Terathon Container Library, by Eric Lengyel.
+// Copyright 1999-2023, Terathon Software LLC
+//
+// This software is distributed under the MIT License.
+// Separate proprietary licenses are available from Terathon Software.
+//
+
+
+#ifndef TSSort_h
+#define TSSort_h
+
+
+//# \component	Utility Library
+//# \prefix		Utilities/
+
+
+#include "TSArray.h"
+
+
+#define TERATHON_SORT 1
+
+
+namespace Terathon
+{
+	//# \class	SortComparator		The default comparator used by the sorting and searching functions.
+	//
+	//# The $SortComparator$ class compares two objects with the $<$ operator.
+	//
+	//# \def	template <typename type> struct SortComparator
+	//
+	//# \tparam		type	The type of the objects being compared.
+	//
+	//# \desc
+	//# The $SortComparator$ class template is the comparator used by $@SortArray@$, $@StableSortArray@$, and the binary
+	//# search functions when no comparator is explicitly specified. Its function call operator returns $true$ if its first
+	//# argument is less than its second argument according to the $<$ operator.
+	//#
+	//# Any comparator passed to the sorting and searching functions must have the same form. That is, it must be callable
+	//# with two objects and return $true$ if and only if the first object should be ordered before the second object.
+	//
+	//# \also	$@KeySortComparator@$
+	//# \also	$@SortArray@$
+
+
+	//# \class	KeySortComparator	A comparator that orders objects by a key extracted from each one.
+	//
+	//# The $KeySortComparator$ class compares two objects by comparing keys that are extracted from them.
+	//
+	//# \def	template <class extractorType> class KeySortComparator
+	//
+	//# \tparam		extractorType	The type of the callable object that extracts a key from an object.
+	//
+	//# \ctor	KeySortComparator(const extractorType& extractor);
+	//
+	//# \param	extractor	A callable object that takes a reference to an object and returns its key.
+	//
+	//# \desc
+	//# The $KeySortComparator$ class template wraps a key extractor so that it can be used as a comparator by the sorting
+	//# functions. Its function call operator returns $true$ if the key extracted from its first argument is less than the
+	//# key extracted from its second argument according to the $<$ operator. The $@SortArrayByKey@$ and
+	//# $@StableSortArrayByKey@$ functions construct a $KeySortComparator$ object internally.
+	//
+	//# \also	$@SortComparator@$
+	//# \also	$@SortArrayByKey@$
+
+
+	//# \function	SortArray		Sorts an array in place.
+	//
+	//# \proto	template <typename type, class comparatorType> void SortArray(type *array, machine count, const comparatorType& compare);
+	//# \proto	template <typename type, typename countType, class comparatorType> void SortArray(ImmutableArray<type, countType>& array, const comparatorType& compare);
+	//# \proto	template <typename type, typename countType> void SortArray(ImmutableArray<type, countType>& array);
+	//
+	//# \param	array		The array to sort.
+	//# \param	count		The number of elements in the array.
+	//# \param	compare		The comparator that determines the order of the elements. If omitted, the $<$ operator is used.
+	//
+	//# \desc
+	//# The $SortArray$ function sorts the elements of an array in place using the introsort algorithm. This is a quicksort
+	//# with median-of-three pivot selection that falls back to heapsort if the recursion becomes too deep and finishes small
+	//# partitions with an insertion sort. The running time is <i>O</i>(<i>n</i>&#x202F;log&#x202F;<i>n</i>) in all cases,
+	//# and no memory is allocated. The sort is not stable, so the relative order of equal elements is not preserved.
+	//#
+	//# Elements are moved by relocation. If the $@TriviallyRelocatable@$ class template indicates that objects of type $type$
+	//# are trivially relocatable, then elements are moved as raw memory without calling constructors or destructors.
+	//
+	//# \also	$@StableSortArray@$
+	//# \also	$@SortArrayByKey@$
+	//# \also	$@LowerBound@$
+
+
+	//# \function	StableSortArray		Sorts an array in place while preserving the order of equal elements.
+	//
+	//# \proto	template <typename type, class comparatorType, class allocatorType, typename countType, class growthType> void StableSortArray(type *array, machine count, const comparatorType& compare, Array<type, 0, allocatorType, countType, growthType>& scratch);
+	//# \proto	template <typename type, typename countType, class comparatorType, class allocatorType, class growthType> void StableSortArray(ImmutableArray<type, countType>& array, const comparatorType& compare, Array<type, 0, allocatorType, countType, growthType>& scratch);
+	//# \proto	template <typename type, typename countType, class comparatorType> void StableSortArray(ImmutableArray<type, countType>& array, const comparatorType& compare);
+	//# \proto	template <typename type, typename countType> void StableSortArray(ImmutableArray<type, countType>& array);
+	//
+	//# \param	array		The array to sort.
+	//# \param	count		The number of elements in the array.
+	//# \param	compare		The comparator that determines the order of the elements. If omitted, the $<$ operator is used.
+	//# \param	scratch		An empty array whose storage is used as temporary space during the sort.
+	//
+	//# \desc
+	//# The $StableSortArray$ function sorts the elements of an array in place using a merge sort. Elements that compare equal
+	//# retain their original relative order. The running time is <i>O</i>(<i>n</i>&#x202F;log&#x202F;<i>n</i>).
+	//#
+	//# The merge sort needs temporary space for half of the elements in the array. This space is taken from the reserved
+	//# storage of the $scratch$ array, which must be empty. The element count of the $scratch$ array is not changed, but its
+	//# storage is enlarged if necessary, so passing the same scratch array to multiple sorts avoids repeated allocations.
+	//# If the $scratch$ parameter is omitted, then a temporary array is allocated for the duration of the sort.
+	//
+	//# \also	$@SortArray@$
+	//# \also	$@StableSortArrayByKey@$
+
+
+	//# \function	SortArrayByKey		Sorts an array in place by a key extracted from each element.
+	//
+	//# \proto	template <typename type, typename countType, class extractorType> void SortArrayByKey(ImmutableArray<type, countType>& array, const extractorType& extractor);
+	//
+	//# \param	array		The array to sort.
+	//# \param	extractor	A callable object that takes a reference to an element and returns its key.
+	//
+	//# \desc
+	//# The $SortArrayByKey$ function sorts the elements of an array in place so that their keys are in ascending order
+	//# according to the $<$ operator. It is equivalent to calling the $@SortArray@$ function with a $@KeySortComparator@$ object.
+	//
+	//# \also	$@SortArray@$
+	//# \also	$@StableSortArrayByKey@$
+
+
+	//# \function	StableSortArrayByKey		Sorts an array in place by a key extracted from each element while preserving the order of equal elements.
+	//
+	//# \proto	template <typename type, typename countType, class extractorType, class allocatorType, class growthType> void StableSortArrayByKey(ImmutableArray<type, countType>& array, const extractorType& extractor, Array<type, 0, allocatorType, countType, growthType>& scratch);
+	//# \proto	template <typename type, typename countType, class extractorType> void StableSortArrayByKey(ImmutableArray<type, countType>& array, const extractorType& extractor);
+	//
+	//# \param	array		The array to sort.
+	//# \param	extractor	A callable object that takes a reference to an element and returns its key.
+	//# \param	scratch		An empty array whose storage is used as temporary space during the sort.
+	//
+	//# \desc
+	//# The $StableSortArrayByKey$ function sorts the elements of an array in place so that their keys are in ascending order
+	//# according to the $<$ operator. It is equivalent to calling the $@StableSortArray@$ function with a $@KeySortComparator@$ object.
+	//
+	//# \also	$@StableSortArray@$
+	//# \also	$@SortArrayByKey@$
+
+
+	//# \function	LowerBound		Returns the first position in a sorted array at which a value could be inserted.
+	//
+	//# \proto	template <typename type, typename countType, typename valueType, class comparatorType> countType LowerBound(const ImmutableArray<type, countType>& array, const valueType& value, const comparatorType& compare);
+	//# \proto	template <typename type, typename countType> countType LowerBound(const ImmutableArray<type, countType>& array, const type& value);
+	//
+	//# \param	array		The sorted array to search.
+	//# \param	value		The value to search for.
+	//# \param	compare		The comparator by which the array is sorted. If omitted, the $<$ operator is used.
+	//
+	//# \desc
+	//# The $LowerBound$ function performs a binary search and returns the index of the first element in an array that is not
+	//# ordered before $value$. If every element is ordered before $value$, then the return value is the number of elements
+	//# in the array. The array must be sorted with respect to the comparator. The comparator is called with an element and
+	//# $value$ as its arguments, in that order, so $value$ does not need to have the same type as the array elements.
+	//
+	//# \also	$@UpperBound@$
+	//# \also	$@BinarySearch@$
+	//# \also	$@LowerBoundByKey@$
+
+
+	//# \function	UpperBound		Returns the last position in a sorted array at which a value could be inserted.
+	//
+	//# \proto	template <typename type, typename countType, typename valueType, class comparatorType> countType UpperBound(const ImmutableArray<type, countType>& array, const valueType& value, const comparatorType& compare);
+	//# \proto	template <typename type, typename countType> countType UpperBound(const ImmutableArray<type, countType>& array, const type& value);
+	//
+	//# \param	array		The sorted array to search.
+	//# \param	value		The value to search for.
+	//# \param	compare		The comparator by which the array is sorted. If omitted, the $<$ operator is used.
+	//
+	//# \desc
+	//# The $UpperBound$ function performs a binary search and returns the index of the first element in an array that $value$
+	//# is ordered before. If there is no such element, then the return value is the number of elements in the array. The array
+	//# must be sorted with respect to the comparator. The comparator is called with $value$ and an element as its arguments,
+	//# in that order, so $value$ does not need to have the same type as the array elements.
+	//
+	//# \also	$@LowerBound@$
+	//# \also	$@BinarySearch@$
+	//# \also	$@UpperBoundByKey@$
+
+
+	//# \function	BinarySearch		Finds a value in a sorted array.
+	//
+	//# \proto	template <typename type, typename countType, typename valueType, class comparatorType> countType BinarySearch(const ImmutableArray<type, countType>& array, const valueType& value, const comparatorType& compare);
+	//# \proto	template <typename type, typename countType> countType BinarySearch(const ImmutableArray<type, countType>& array, const type& value);
+	//
+	//# \param	array		The sorted array to search.
+	//# \param	value		The value to search for.
+	//# \param	compare		The comparator by which the array is sorted. If omitted, the $<$ operator is used.
+	//
+	//# \desc
+	//# The $BinarySearch$ function searches a sorted array for an element that is equivalent to $value$, meaning that neither
+	//# is ordered before the other. If such an element exists, then the index of the first one is returned. Otherwise, the
+	//# return value is &minus;1. The running time of this function is <i>O</i>(log&#x202F;<i>n</i>), where <i>n</i> is the
+	//# number of elements in the array.
+	//
+	//# \also	$@LowerBound@$
+	//# \also	$@UpperBound@$
+	//# \also	$@BinarySearchByKey@$
+
+
+	//# \function	LowerBoundByKey		Returns the first position in an array sorted by key at which a key could be inserted.
+	//
+	//# \proto	template <typename type, typename countType, typename keyType, class extractorType> countType LowerBoundByKey(const ImmutableArray<type, countType>& array, const keyType& key, const extractorType& extractor);
+	//
+	//# \param	array		The sorted array to search.
+	//# \param	key			The key to search for.
+	//# \param	extractor	A callable object that takes a reference to an element and returns its key.
+	//
+	//# \desc
+	//# The $LowerBoundByKey$ function performs a binary search and returns the index of the first element in an array whose
+	//# key is not less than $key$. If there is no such element, then the return value is the number of elements in the array.
+	//# The array must be sorted so that the keys of its elements are in ascending order.
+	//
+	//# \also	$@UpperBoundByKey@$
+	//# \also	$@BinarySearchByKey@$
+	//# \also	$@LowerBound@$
+
+
+	//# \function	UpperBoundByKey		Returns the last position in an array sorted by key at which a key could be inserted.
+	//
+	//# \proto	template <typename type, typename countType, typename keyType, class extractorType> countType UpperBoundByKey(const ImmutableArray<type, countType>& array, const keyType& key, const extractorType& extractor);
+	//
+	//# \param	array		The sorted array to search.
+	//# \param	key			The key to search for.
+	//# \param	extractor	A callable object that takes a reference to an element and returns its key.
+	//
+	//# \desc
+	//# The $UpperBoundByKey$ function performs a binary search and returns the index of the first element in an array whose
+	//# key is greater than $key$. If there is no such element, then the return value is the number of elements in the array.
+	//# The array must be sorted so that the keys of its elements are in ascending order.
+	//
+	//# \also	$@LowerBoundByKey@$
+	//# \also	$@BinarySearchByKey@$
+	//# \also	$@UpperBound@$
+
+
+	//# \function	BinarySearchByKey		Finds an element having a particular key in an array sorted by key.
+	//
+	//# \proto	template <typename type, typename countType, typename keyType, class extractorType> countType BinarySearchByKey(const ImmutableArray<type, countType>& array, const keyType& key, const extractorType& extractor);
+	//
+	//# \param	array		The sorted array to search.
+	//# \param	key			The key to search for.
+	//# \param	extractor	A callable object that takes a reference to an element and returns its key.
+	//
+	//# \desc
+	//# The $BinarySearchByKey$ function searches an array sorted by key for an element whose key is equal to $key$ based on
+	//# the $<$ operator. If such an element exists, then the index of the first one is returned. Otherwise, the return value
+	//# is &minus;1.
+	//
+	//# \also	$@LowerBoundByKey@$
+	//# \also	$@UpperBoundByKey@$
+	//# \also	$@BinarySearch@$
+
+
+	//# \function	RadixSortArray		Sorts an array by integer or floating-point keys using a radix sort.
+	//
+	//# \proto	template <typename type, typename countType, class extractorType, class allocatorType, class growthType> void RadixSortArray(ImmutableArray<type, countType>& array, const extractorType& extractor, Array<type, 0, allocatorType, countType, growthType>& scratch);
+	//# \proto	template <typename type, typename countType, class extractorType> void RadixSortArray(ImmutableArray<type, countType>& array, const extractorType& extractor);
+	//# \proto	template <typename type, typename countType> void RadixSortArray(ImmutableArray<type, countType>& array);
+	//
+	//# \param	array		The array to sort.
+	//# \param	extractor	A callable object that takes a reference to an element and returns its key. If omitted, the elements themselves are the keys.
+	//# \param	scratch		An empty array whose storage is used as temporary space during the sort.
+	//
+	//# \desc
+	//# The $RadixSortArray$ function sorts the elements of an array in place so that their keys are in ascending order using a
+	//# least-significant-digit radix sort with 8-bit digits. The sort is stable, and its running time is <i>O</i>(<i>kn</i>),
+	//# where <i>n</i> is the number of elements in the array and <i>k</i> is the size of the key in bytes.
+	//#
+	//# The key returned by the extractor must be an 8-bit, 16-bit, 32-bit, or 64-bit signed or unsigned integer, a $float$, or a
+	//# $double$. Signed integers and floating-point values are transformed into unsigned integers that have the same order, so
+	//# negative values are sorted correctly. For floating-point keys, negative zero is ordered before positive zero, and NaNs are
+	//# ordered before all negative values or after all positive values according to their sign bits.
+	//#
+	//# The histograms for all digits are gathered in a single pass over the array before any elements are moved. Any digit
+	//# for which every element falls into the same bucket is skipped, so sorting keys that only use their low bits takes
+	//# fewer passes. Small arrays are sorted with an insertion sort instead.
+	//#
+	//# The radix sort needs temporary space for the same number of elements as the array. This space is taken from the reserved
+	//# storage of the $scratch$ array, which must be empty. The element count of the $scratch$ array is not changed, but its
+	//# storage is enlarged if necessary, so passing the same scratch array to multiple sorts avoids repeated allocations.
+	//# If the $scratch$ parameter is omitted, then a temporary array is allocated for the duration of the sort.
+	//
+	//# \also	$@SortArray@$
+	//# \also	$@StableSortArrayByKey@$
+
+
+	template <typename type>
+	struct SortComparator
+	{
+		bool operator ()(const type& x, const type& y) const
+		{
+			return (x < y);
+		}
+	};
+
+
+	template <class extractorType>
+	class KeySortComparator
+	{
+		private:
+
+			extractorType		keyExtractor;
+
+		public:
+
+			KeySortComparator(const extractorType& extractor) : keyExtractor(extractor) {}
+
+			template <typename type>
+			bool operator ()(const type& x, const type& y) const
+			{
+				return (keyExtractor(x) < keyExtractor(y));
+			}
+	};
+
+
+	namespace Sort
+	{
+		enum
+		{
+			kInsertionSortCount		= 16
+		};
+
+
+		template <typename type>
+		inline void SwapElements(type *x, type *y)
+		{
+			alignas(type) char	storage[sizeof(type)];
+
+			type *temp = reinterpret_cast<type *>(storage);
+			RelocateArrayElements(temp, x, 1);
+			RelocateArrayElements(x, y, 1);
+			RelocateArrayElements(y, temp, 1);
+		}
+
+		template <typename type, class comparatorType>
+		void InsertionSort(type *array, machine count, const comparatorType& compare)
+		{
+			alignas(type) char	storage[sizeof(type)];
+			type *temp = reinterpret_cast<type *>(storage);
+
+			for (machine a = 1; a < count; a++)
+			{
+				if (compare(array[a], array[a - 1]))
+				{
+					// Lift the element out, slide the larger elements up with a single
+					// relocation of the whole block, and drop the element into the hole.
+
+					RelocateArrayElements(temp, &array[a], 1);
+
+					machine b = a - 1;
+					while ((b > 0) && (compare(*temp, array[b - 1])))
+					{
+						b--;
+					}
+
+					RelocateArrayElements(&array[b + 1], &array[b], a - b);
+					RelocateArrayElements(&array[b], temp, 1);
+				}
+			}
+		}
+
+		template <typename type, class comparatorType>
+		void SiftDown(type *array, machine root, machine count, const comparatorType& compare)
+		{
+			for (;;)
+			{
+				machine child = root * 2 + 1;
+				if (child >= count)
+				{
+					break;
+				}
+
+				if ((child + 1 < count) && (compare(array[child], array[child + 1])))
+				{
+					child++;
+				}
+
+				if (!compare(array[root], array[child]))
+				{
+					break;
+				}
+
+				SwapElements(&array[root], &array[child]);
+				root = child;
+			}
+		}
+
+		template <typename type, class comparatorType>
+		void HeapSort(type *array, machine count, const comparatorType& compare)
+		{
+			for (machine a = count / 2 - 1; a >= 0; a--)
+			{
+				SiftDown(array, a, count, compare);
+			}
+
+			for (machine a = count - 1; a > 0; a--)
+			{
+				SwapElements(&array[0], &array[a]);
+				SiftDown(array, 0, a, compare);
+			}
+		}
+
+		template <typename type, class comparatorType>
+		void IntroSort(type *array, machine count, int32 depth, const comparatorType& compare)
+		{
+			while (count > kInsertionSortCount)
+			{
+				if (depth == 0)
+				{
+					HeapSort(array, count, compare);
+					return;
+				}
+
+				depth--;
+
+				// Order the first, middle, and last elements, and then park the median
+				// next to the end. The first and last elements act as sentinels for the
+				// partitioning loops below, so they never need bounds checks.
+
+				type *last = &array[count - 1];
+				type *middle = &array[count / 2];
+
+				if (compare(*middle, array[0]))
+				{
+					SwapElements(middle, &array[0]);
+				}
+
+				if (compare(*last, *middle))
+				{
+					SwapElements(last, middle);
+					if (compare(*middle, array[0]))
+					{
+						SwapElements(middle, &array[0]);
+					}
+				}
+
+				type *pivot = last - 1;
+				SwapElements(middle, pivot);
+
+				machine i = 0;
+				machine j = count - 2;
+				for (;;)
+				{
+					while (compare(array[++i], *pivot)) {}
+					while (compare(*pivot, array[--j])) {}
+
+					if (i >= j)
+					{
+						break;
+					}
+
+					SwapElements(&array[i], &array[j]);
+				}
+
+				SwapElements(&array[i], pivot);
+
+				// Recurse into the smaller partition and loop on the larger one so that
+				// the stack depth stays logarithmic in the array size.
+
+				machine rightCount = count - i - 1;
+				if (i < rightCount)
+				{
+					IntroSort(array, i, depth, compare);
+					array += i + 1;
+					count = rightCount;
+				}
+				else
+				{
+					IntroSort(array + (i + 1), rightCount, depth, compare);
+					count = i;
+				}
+			}
+
+			InsertionSort(array, count, compare);
+		}
+
+		template <typename type, class comparatorType>
+		void MergeSort(type *array, machine count, type *buffer, const comparatorType& compare)
+		{
+			if (count <= kInsertionSortCount)
+			{
+				InsertionSort(array, count, compare);
+				return;
+			}
+
+			machine half = count / 2;
+			MergeSort(array, half, buffer, compare);
+			MergeSort(array + half, count - half, buffer, compare);
+
+			if (!compare(array[half], array[half - 1]))
+			{
+				return;
+			}
+
+			// Move the first half into the buffer and merge it with the second half back into
+			// the array. The destination never overtakes the unmerged part of the second half.
+
+			RelocateArrayElements(buffer, array, half);
+
+			machine i = 0;
+			machine j = half;
+			machine k = 0;
+
+			while ((i < half) && (j < count))
+			{
+				if (compare(array[j], buffer[i]))
+				{
+					RelocateArrayElements(&array[k], &array[j], 1);
+					j++;
+				}
+				else
+				{
+					RelocateArrayElements(&array[k], &buffer[i], 1);
+					i++;
+				}
+
+				k++;
+			}
+
+			RelocateArrayElements(&array[k], &buffer[i], half - i);
+		}
+
+		template <typename type, class predicateType>
+		machine FindPartitionPoint(const type *array, machine count, const predicateType& predicate)
+		{
+			machine first = 0;
+			while (count > 0)
+			{
+				machine half = count >> 1;
+				if (predicate(array[first + half]))
+				{
+					first += half + 1;
+					count -= half + 1;
+				}
+				else
+				{
+					count = half;
+				}
+			}
+
+			return (first);
+		}
+	}
+
+
+	template <typename type, class comparatorType>
+	void SortArray(type *array, machine count, const comparatorType& compare)
+	{
+		if (count > 1)
+		{
+			Sort::IntroSort(array, count, IntLog2(uint32(Min64(count, 0x7FFFFFFF))) * 2 + 2, compare);
+		}
+	}
+
+	template <typename type, typename countType, class comparatorType>
+	inline void SortArray(ImmutableArray<type, countType>& array, const comparatorType& compare)
+	{
+		SortArray(static_cast<type *>(array), array.GetArrayElementCount(), compare);
+	}
+
+	template <typename type, typename countType>
+	inline void SortArray(ImmutableArray<type, countType>& array)
+	{
+		SortArray(static_cast<type *>(array), array.GetArrayElementCount(), SortComparator<type>());
+	}
+
+	template <typename type, class comparatorType, class allocatorType, typename countType, class growthType>
+	void StableSortArray(type *array, machine count, const comparatorType& compare, Array<type, 0, allocatorType, countType, growthType>& scratch)
+	{
+		if (count > Sort::kInsertionSortCount)
+		{
+			scratch.ReserveArrayElementCount(countType(count / 2));
+			Sort::MergeSort(array, count, static_cast<type *>(scratch), compare);
+		}
+		else
+		{
+			Sort::InsertionSort(array, count, compare);
+		}
+	}
+
+	template <typename type, typename countType, class comparatorType, class allocatorType, class growthType>
+	inline void StableSortArray(ImmutableArray<type, countType>& array, const comparatorType& compare, Array<type, 0, allocatorType, countType, growthType>& scratch)
+	{
+		StableSortArray(static_cast<type *>(array), array.GetArrayElementCount(), compare, scratch);
+	}
+
+	template <typename type, typename countType, class comparatorType>
+	inline void StableSortArray(ImmutableArray<type, countType>& array, const comparatorType& compare)
+	{
+		Array<type, 0, HeapArrayAllocator, countType>		scratch;
+
+		StableSortArray(static_cast<type *>(array), array.GetArrayElementCount(), compare, scratch);
+	}
+
+	template <typename type, typename countType>
+	inline void StableSortArray(ImmutableArray<type, countType>& array)
+	{
+		Array<type, 0, HeapArrayAllocator, countType>		scratch;
+
+		StableSortArray(static_cast<type *>(array), array.GetArrayElementCount(), SortComparator<type>(), scratch);
+	}
+
+	template <typename type, typename countType, class extractorType>
+	inline void SortArrayByKey(ImmutableArray<type, countType>& array, const extractorType& extractor)
+	{
+		SortArray(static_cast<type *>(array), array.GetArrayElementCount(), KeySortComparator<extractorType>(extractor));
+	}
+
+	template <typename type, typename countType, class extractorType, class allocatorType, class growthType>
+	inline void StableSortArrayByKey(ImmutableArray<type, countType>& array, const extractorType& extractor, Array<type, 0, allocatorType, countType, growthType>& scratch)
+	{
+		StableSortArray(static_cast<type *>(array), array.GetArrayElementCount(), KeySortComparator<extractorType>(extractor), scratch);
+	}
+
+	template <typename type, typename countType, class extractorType>
+	inline void StableSortArrayByKey(ImmutableArray<type, countType>& array, const extractorType& extractor)
+	{
+		Array<type, 0, HeapArrayAllocator, countType>		scratch;
+
+		StableSortArray(static_cast<type *>(array), array.GetArrayElementCount(), KeySortComparator<extractorType>(extractor), scratch);
+	}
+
+
+	template <typename type, typename countType, typename valueType, class comparatorType>
+	countType LowerBound(const ImmutableArray<type, countType>& array, const valueType& value, const comparatorType& compare)
+	{
+		return (countType(Sort::FindPartitionPoint(static_cast<const type *>(array), array.GetArrayElementCount(), [&](const type& element) -> bool
+		{
+			return (compare(element, value));
+		})));
+	}
+
+	template <typename type, typename countType>
+	inline countType LowerBound(const ImmutableArray<type, countType>& array, const type& value)
+	{
+		return (LowerBound(array, value, SortComparator<type>()));
+	}
+
+	template <typename type, typename countType, typename valueType, class comparatorType>
+	countType UpperBound(const ImmutableArray<type, countType>& array, const valueType& value, const comparatorType& compare)
+	{
+		return (countType(Sort::FindPartitionPoint(static_cast<const type *>(array), array.GetArrayElementCount(), [&](const type& element) -> bool
+		{
+			return (!compare(value, element));
+		})));
+	}
+
+	template <typename type, typename countType>
+	inline countType UpperBound(const ImmutableArray<type, countType>& array, const type& value)
+	{
+		return (UpperBound(array, value, SortComparator<type>()));
+	}
+
+	template <typename type, typename countType, typename valueType, class comparatorType>
+	countType BinarySearch(const ImmutableArray<type, countType>& array, const valueType& value, const comparatorType& compare)
+	{
+		countType index = LowerBound(array, value, compare);
+		if ((index < array.GetArrayElementCount()) && (!compare(value, static_cast<const type *>(array)[index])))
+		{
+			return (index);
+		}
+
+		return (-1);
+	}
+
+	template <typename type, typename countType>
+	inline countType BinarySearch(const ImmutableArray<type, countType>& array, const type& value)
+	{
+		return (BinarySearch(array, value, SortComparator<type>()));
+	}
+
+	template <typename type, typename countType, typename keyType, class extractorType>
+	countType LowerBoundByKey(const ImmutableArray<type, countType>& array, const keyType& key, const extractorType& extractor)
+	{
+		return (countType(Sort::FindPartitionPoint(static_cast<const type *>(array), array.GetArrayElementCount(), [&](const type& element) -> bool
+		{
+			return (extractor(element) < key);
+		})));
+	}
+
+	template <typename type, typename countType, typename keyType, class extractorType>
+	countType UpperBoundByKey(const ImmutableArray<type, countType>& array, const keyType& key, const extractorType& extractor)
+	{
+		return (countType(Sort::FindPartitionPoint(static_cast<const type *>(array), array.GetArrayElementCount(), [&](const type& element) -> bool
+		{
+			return (!(key < extractor(element)));
+		})));
+	}
+
+	template <typename type, typename countType, typename keyType, class extractorType>
+	countType BinarySearchByKey(const ImmutableArray<type, countType>& array, const keyType& key, const extractorType& extractor)
+	{
+		countType index = LowerBoundByKey(array, key, extractor);
+		if ((index < array.GetArrayElementCount()) && (!(key < extractor(static_cast<const type *>(array)[index]))))
+		{
+			return (index);
+		}
+
+		return (-1);
+	}
+
+	template <typename keyType>
+	struct RadixKey;
+
+	template <> struct RadixKey<uint8> {typedef uint8 type; static uint8 Transform(uint8 k) {return (k);}};
+	template <> struct RadixKey<uint16> {typedef uint16 type; static uint16 Transform(uint16 k) {return (k);}};
+	template <> struct RadixKey<uint32> {typedef uint32 type; static uint32 Transform(uint32 k) {return (k);}};
+	template <> struct RadixKey<uint64> {typedef uint64 type; static uint64 Transform(uint64 k) {return (k);}};
+	template <> struct RadixKey<int8> {typedef uint8 type; static uint8 Transform(int8 k) {return (uint8(k ^ 0x80));}};
+	template <> struct RadixKey<int16> {typedef uint16 type; static uint16 Transform(int16 k) {return (uint16(k ^ 0x8000));}};
+	template <> struct RadixKey<int32> {typedef uint32 type; static uint32 Transform(int32 k) {return (uint32(k) ^ 0x80000000U);}};
+	template <> struct RadixKey<int64> {typedef uint64 type; static uint64 Transform(int64 k) {return (uint64(k) ^ 0x8000000000000000ULL);}};
+
+	template <>
+	struct RadixKey<float>
+	{
+		typedef uint32 type;
+
+		static uint32 Transform(float k)
+		{
+			// Flip all bits of negative values so that larger magnitudes sort lower,
+			// and flip only the sign bit of positive values so that they sort above.
+
+			uint32 i = asuint(k);
+			return (i ^ (uint32(int32(i) >> 31) | 0x80000000U));
+		}
+	};
+
+	template <>
+	struct RadixKey<double>
+	{
+		typedef uint64 type;
+
+		static uint64 Transform(double k)
+		{
+			uint64 i;
+			memcpy(&i, &k, 8);
+			return (i ^ (uint64(int64(i) >> 63) | 0x8000000000000000ULL));
+		}
+	};
+
+
+	template <typename type>
+	struct RadixIdentity
+	{
+		const type& operator ()(const type& x) const
+		{
+			return (x);
+		}
+	};
+
+
+	namespace Sort
+	{
+		enum
+		{
+			kRadixSortMinCount		= 64
+		};
+
+
+		template <typename T> struct RemoveConstRef {typedef T type;};
+		template <typename T> struct RemoveConstRef<const T> {typedef T type;};
+		template <typename T> struct RemoveConstRef<T&> {typedef T type;};
+		template <typename T> struct RemoveConstRef<const T&> {typedef T type;};
+		template <typename T> struct RemoveConstRef<T&&> {typedef T type;};
+
+
+		template <class extractorType>
+		class RadixKeyComparator
+		{
+			private:
+
+				const extractorType&	keyExtractor;
+
+			public:
+
+				RadixKeyComparator(const extractorType& extractor) : keyExtractor(extractor) {}
+
+				template <typename type>
+				bool operator ()(const type& x, const type& y) const
+				{
+					typedef RadixKey<typename RemoveConstRef<decltype(keyExtractor(x))>::type>		radixType;
+
+					return (radixType::Transform(keyExtractor(x)) < radixType::Transform(keyExtractor(y)));
+				}
+		};
+
+
+		template <typename type, class extractorType>
+		void RadixSort(type *array, machine count, type *buffer, const extractorType& extractor)
+		{
+			typedef RadixKey<typename RemoveConstRef<decltype(extractor(*array))>::type>	radixType;
+			typedef typename radixType::type												keyType;
+
+			enum
+			{
+				kDigitCount = sizeof(keyType)
+			};
+
+			machine		histogram[kDigitCount][256];
+
+			for (machine d = 0; d < kDigitCount; d++)
+			{
+				for (machine b = 0; b < 256; b++)
+				{
+					histogram[d][b] = 0;
+				}
+			}
+
+			for (machine a = 0; a < count; a++)
+			{
+				keyType key = radixType::Transform(extractor(array[a]));
+				for (machine d = 0; d < kDigitCount; d++)
+				{
+					histogram[d][(key >> (d * 8)) & 0xFF]++;
+				}
+			}
+
+			type *source = array;
+			type *dest = buffer;
+
+			for (machine d = 0; d < kDigitCount; d++)
+			{
+				// If every element has the same value in this digit, then the pass would
+				// not change the order of anything, so it is skipped entirely.
+
+				machine *bucket = histogram[d];
+				if (bucket[(radixType::Transform(extractor(source[0])) >> (d * 8)) & 0xFF] == count)
+				{
+					continue;
+				}
+
+				machine offset = 0;
+				for (machine b = 0; b < 256; b++)
+				{
+					machine c = bucket[b];
+					bucket[b] = offset;
+					offset += c;
+				}
+
+				for (machine a = 0; a < count; a++)
+				{
+					machine index = bucket[(radixType::Transform(extractor(source[a])) >> (d * 8)) & 0xFF]++;
+					RelocateArrayElements(&dest[index], &source[a], 1);
+				}
+
+				type *temp = source;
+				source = dest;
+				dest = temp;
+			}
+
+			if (source != array)
+			{
+				RelocateArrayElements(array, source, count);
+			}
+		}
+	}
+
+
+	template <typename type, typename countType, class extractorType, class allocatorType, class growthType>
+	void RadixSortArray(ImmutableArray<type, countType>& array, const extractorType& extractor, Array<type, 0, allocatorType, countType, growthType>& scratch)
+	{
+		type *pointer = array;
+		countType count = array.GetArrayElementCount();
+
+		if (count > Sort::kRadixSortMinCount)
+		{
+			scratch.ReserveArrayElementCount(count);
+			Sort::RadixSort(pointer, count, static_cast<type *>(scratch), extractor);
+		}
+		else
+		{
+			Sort::InsertionSort(pointer, count, Sort::RadixKeyComparator<extractorType>(extractor));
+		}
+	}
+
+	template <typename type, typename countType, class extractorType>
+	inline void RadixSortArray(ImmutableArray<type, countType>& array, const extractorType& extractor)
+	{
+		Array<type, 0, HeapArrayAllocator, countType>		scratch;
+
+		RadixSortArray(array, extractor, scratch);
+	}
+
+	template <typename type, typename countType>
+	inline void RadixSortArray(ImmutableArray<type, countType>& array)
+	{
+		Array<type, 0, HeapArrayAllocator, countType>		scratch;
+
+		RadixSortArray(array, RadixIdentity<type>(), scratch);
+	}
+}
+
+
+#endif